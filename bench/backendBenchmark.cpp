@@ -0,0 +1,134 @@
+// Compares the throughput and the accuracy of the scalar backends of the
+// simulation core. Every backend flies the same random genomes on each level,
+// the double backend being the reference for the accuracy figures.
+//
+// Usage : BACKEND_BENCHMARK [levelDirectory] [numberOfGenomes]
+
+#include "level.hpp"
+#include "phenotype.hpp"
+#include "rollout.hpp"
+#include "fixedPoint.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Outcome
+    {
+        Point2d position;
+        double score;
+        bool hasCrashed;
+        bool hasLanded;
+    };
+
+    struct BackendResult
+    {
+        std::string name;
+        double seconds;
+        std::size_t steps;
+        std::vector<Outcome> outcomes;
+    };
+
+    template <typename T>
+    BackendResult runBackend(const std::string& name, const Level& level, std::vector<Phenotype> population)
+    {
+        const BasicTerrain<T> terrain(polylineCast<T>(level.surfacePoints));
+        const BasicLander<T> lander(pointCast<T>(level.data.position), pointCast<T>(level.data.velocity),
+                                    level.data.fuel, level.data.angle, level.data.thrust);
+
+        BackendResult result{name, 0.0, 0, {}};
+        result.outcomes.reserve(population.size());
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (Phenotype& phenotype : population)
+        {
+            const RolloutResult<T> rolloutResult = rollout(lander, phenotype, terrain);
+            phenotype.computeScore(rolloutResult.lander, terrain);
+
+            result.steps += rolloutResult.steps;
+            result.outcomes.push_back({pointCast<double>(rolloutResult.lander.position()), phenotype.score(),
+                                       rolloutResult.impact.has_value(), rolloutResult.hasLanded});
+        }
+
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return result;
+    }
+
+    void printResult(const BackendResult& result, const BackendResult& reference)
+    {
+        std::size_t sameOutcome = 0;
+        std::size_t landings = 0;
+        double maxPositionError = 0.0;
+        double sumPositionError = 0.0;
+        double maxScoreError = 0.0;
+
+        for (std::size_t i = 0; i < result.outcomes.size(); ++i)
+        {
+            const Outcome& outcome = result.outcomes[i];
+            const Outcome& expected = reference.outcomes[i];
+
+            if (outcome.hasCrashed == expected.hasCrashed && outcome.hasLanded == expected.hasLanded)
+                sameOutcome++;
+            if (outcome.hasLanded)
+                landings++;
+
+            const double positionError = utils::length(outcome.position, expected.position);
+            sumPositionError += positionError;
+            maxPositionError = std::max(maxPositionError, positionError);
+            maxScoreError = std::max(maxScoreError, std::abs(outcome.score - expected.score));
+        }
+
+        const double count = static_cast<double>(result.outcomes.size());
+
+        std::cout << std::left << std::setw(8) << result.name << std::right << std::fixed
+                  << std::setw(14) << std::setprecision(0) << count / result.seconds
+                  << std::setw(14) << std::setprecision(0) << result.steps / result.seconds
+                  << std::setw(10) << landings
+                  << std::setw(12) << std::setprecision(2) << 100.0 * sameOutcome / count
+                  << std::setw(14) << std::setprecision(3) << sumPositionError / count
+                  << std::setw(14) << std::setprecision(3) << maxPositionError
+                  << std::setw(12) << std::setprecision(4) << maxScoreError << "\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string levelDirectory = argc > 1 ? argv[1] : "resources/data";
+    const std::size_t numberOfGenomes = argc > 2 ? std::stoul(argv[2]) : 2000;
+
+    for (int id = 1; id <= 5; ++id)
+    {
+        const std::string fileName = levelDirectory + "/level_0" + std::to_string(id) + ".txt";
+        const Level level = loadLevel(fileName);
+
+        std::vector<Phenotype> population;
+        population.reserve(numberOfGenomes);
+        for (std::size_t i = 0; i < numberOfGenomes; ++i)
+        {
+            population.emplace_back();
+        }
+
+        const BackendResult reference = runBackend<double>("double", level, population);
+        const BackendResult single = runBackend<float>("float", level, population);
+        const BackendResult fixed = runBackend<Fixed>("fixed", level, population);
+
+        std::cout << "\n" << fileName << " - " << numberOfGenomes << " genomes\n"
+                  << std::left << std::setw(8) << "backend" << std::right
+                  << std::setw(14) << "rollouts/s" << std::setw(14) << "steps/s" << std::setw(10) << "landings"
+                  << std::setw(12) << "same end %" << std::setw(14) << "mean err (m)" << std::setw(14) << "max err (m)"
+                  << std::setw(12) << "score err" << "\n";
+
+        printResult(reference, reference);
+        printResult(single, reference);
+        printResult(fixed, reference);
+    }
+
+    return 0;
+}
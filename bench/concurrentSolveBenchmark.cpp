@@ -0,0 +1,99 @@
+// Runs many solves at once through solveAsync, on the five levels with
+// different seeds and the same time budget, and reports how late the slowest
+// ones answered past their budget. One more solve is cancelled as soon as it
+// starts, and the time it took to answer is reported too.
+//
+// Usage : CONCURRENT_SOLVE_BENCHMARK [levelDirectory] [numberOfSolves] [budgetMilliseconds]
+
+#include "level.hpp"
+#include "solveAsync.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char* statusName(SolveStatus status)
+    {
+        switch (status)
+        {
+            case SolveStatus::LANDED: return "landed";
+            case SolveStatus::OUT_OF_ITERATIONS: return "out of iterations";
+            case SolveStatus::OUT_OF_TIME: return "out of time";
+            case SolveStatus::CANCELLED: return "cancelled";
+        }
+
+        return "";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string levelDirectory = argc > 1 ? argv[1] : "resources/data";
+    const std::size_t numberOfSolves = std::max<std::size_t>(1, argc > 2 ? std::stoul(argv[2]) : 20);
+    const std::chrono::milliseconds budget(argc > 3 ? std::stoul(argv[3]) : 2000);
+
+    std::vector<Level> levels;
+    for (int id = 1; id <= 5; ++id)
+    {
+        levels.push_back(loadLevel(levelDirectory + "/level_0" + std::to_string(id) + ".txt"));
+    }
+
+    std::atomic<std::size_t> numberOfProgressCalls(0);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::future<Solution>> futures;
+    for (std::size_t i = 0; i < numberOfSolves; ++i)
+    {
+        SolverConfig config;
+        config.seed = i + 1;
+
+        SolveOptions options;
+        options.timeBudget = budget;
+        options.onProgress = [&numberOfProgressCalls] (const SolveProgress&) { numberOfProgressCalls++; };
+        futures.push_back(solveAsync(levels[i % levels.size()], config, options));
+    }
+
+    SolveOptions cancelledOptions;
+    std::future<Solution> cancelled = solveAsync(levels.back(), SolverConfig(), cancelledOptions);
+    const auto cancelTime = std::chrono::steady_clock::now();
+    cancelledOptions.cancellation.cancel();
+    const Solution cancelledSolution = cancelled.get();
+    const double cancelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - cancelTime).count();
+
+    std::vector<double> answerSeconds;
+    std::size_t landings = 0;
+
+    std::cout << numberOfSolves << " solves at once, budget of " << budget.count() << " ms\n"
+              << std::left << std::setw(8) << "solve" << std::setw(20) << "status" << std::right << std::setw(12) << "iterations"
+              << std::setw(12) << "best score" << std::setw(12) << "seconds" << "\n";
+
+    for (std::size_t i = 0; i < futures.size(); ++i)
+    {
+        const Solution solution = futures[i].get();
+        landings += solution.status == SolveStatus::LANDED;
+        answerSeconds.push_back(solution.seconds);
+
+        std::cout << std::left << std::setw(8) << i << std::setw(20) << statusName(solution.status) << std::right
+                  << std::setw(12) << solution.numberOfIterations << std::fixed << std::setprecision(2)
+                  << std::setw(12) << solution.bestScore << std::setw(12) << solution.seconds << "\n";
+    }
+
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::sort(answerSeconds.begin(), answerSeconds.end());
+    const double budgetSeconds = std::chrono::duration<double>(budget).count();
+    std::cout << "Landings : " << landings << " / " << numberOfSolves << ", progress calls : " << numberOfProgressCalls << "\n"
+              << "Slowest answer : " << answerSeconds.back() << " s, " << std::max(0.0, answerSeconds.back() - budgetSeconds)
+              << " s past the budget, all answered after " << wallSeconds << " s\n"
+              << "Cancelled solve : " << statusName(cancelledSolution.status) << " after " << cancelledSolution.numberOfIterations
+              << " iterations, " << cancelSeconds << " s after the cancel\n";
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+// Measures the cost of the niche counts of the fitness sharing, exact and
+// approximated, against the evaluation of the generation, and the error of the
+// approximations. The reference is a plain loop over the genes of each pair.
+// The populations are clusters of mutants around a few centres, so that the
+// niches are not all empty.
+//
+// Usage : NICHING_BENCHMARK [levelFile] [numberOfGenes]
+
+#include "level.hpp"
+#include "niching.hpp"
+#include "rollout.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::size_t s_numberOfCentres = 50;
+    const double s_mutationRate = 0.05;
+    // The pairwise reference is only timed up to this size
+    const std::size_t s_largestNaiveSize = 4000;
+
+    std::vector<Phenotype> clusteredPopulation(std::size_t size, std::size_t numberOfGenes, utils::RandomEngine& engine)
+    {
+        std::vector<Phenotype> centres;
+        for (std::size_t i = 0; i < s_numberOfCentres; ++i)
+        {
+            centres.emplace_back(numberOfGenes, engine);
+        }
+
+        std::vector<Phenotype> population;
+        population.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            Phenotype phenotype = centres[utils::uniform(engine, 0, s_numberOfCentres - 1)];
+            for (Gene& gene : phenotype.genes())
+            {
+                if (utils::uniform(engine, 0., 1.) < s_mutationRate)
+                {
+                    gene.angle = static_cast<std::int8_t>(utils::uniform(engine, -90, 90));
+                    gene.thrust = static_cast<std::int8_t>(utils::uniform(engine, -1, 1));
+                }
+            }
+            population.push_back(std::move(phenotype));
+        }
+
+        return population;
+    }
+
+    template <typename Function>
+    double measure(Function&& function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Mean relative deviation of the niche sizes from the exact ones, which
+    // are the ratios of the shared scores
+    double deviation(const std::vector<double>& scores, const std::vector<double>& exact)
+    {
+        double sum = 0.0;
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < scores.size(); ++i)
+        {
+            if (scores[i] > 0.0)
+            {
+                sum += std::abs(exact[i] / scores[i] - 1.0);
+                count++;
+            }
+        }
+
+        return count > 0 ? sum / count : 0.0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string levelFile = argc > 1 ? argv[1] : "resources/data/level_02.txt";
+    const std::size_t numberOfGenes = argc > 2 ? std::stoul(argv[2]) : 160;
+    const Level level = loadLevel(levelFile);
+    const Terrain terrain(level.surfacePoints);
+    const Lander lander(level.data.position, level.data.velocity, level.data.fuel, level.data.angle, level.data.thrust);
+
+    utils::RandomEngine engine(42);
+    double checksum = 0.0;
+
+    std::cout << "Niche counts of one generation of " << numberOfGenes << " genes, in ms, and deviation of the approximations\n"
+              << std::left << std::setw(12) << "population" << std::right << std::setw(12) << "eval"
+              << std::setw(12) << "naive" << std::setw(12) << "exact" << std::setw(20) << "sampling" << std::setw(20) << "lsh" << "\n";
+
+    for (std::size_t size : {1000, 2000, 4000, 10000})
+    {
+        std::vector<Phenotype> population = clusteredPopulation(size, numberOfGenes, engine);
+
+        const double evaluation = measure([&] ()
+        {
+            for (Phenotype& phenotype : population)
+            {
+                phenotype.computeScore(rollout(lander, phenotype, terrain).lander, terrain);
+            }
+        });
+
+        std::cout << std::left << std::setw(12) << size << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << 1000.0 * evaluation;
+
+        NichingConfig config;
+        if (size <= s_largestNaiveSize)
+        {
+            const double naive = measure([&] ()
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                    for (std::size_t j = i + 1; j < size; ++j)
+                        checksum += std::max(0.0, 1.0 - Niching::distance(population[i], population[j]) / config.radius);
+            });
+            std::cout << std::setw(12) << 1000.0 * naive;
+        }
+        else
+        {
+            std::cout << std::setw(12) << "-";
+        }
+
+        Niching exactNiching(config);
+        std::vector<double> exact;
+        const double exactTime = measure([&] () { exact = exactNiching.sharedScores(population, engine); });
+        std::cout << std::setw(12) << 1000.0 * exactTime;
+
+        for (NichingApproximation approximation : {NichingApproximation::SAMPLING, NichingApproximation::LSH})
+        {
+            config.approximation = approximation;
+            Niching niching(config);
+            std::vector<double> scores;
+            const double seconds = measure([&] () { scores = niching.sharedScores(population, engine); });
+
+            const std::string cell = std::to_string(static_cast<int>(10000.0 * seconds + 0.5) / 10.0);
+            const std::string error = std::to_string(static_cast<int>(1000.0 * deviation(scores, exact) + 0.5) / 10.0);
+            std::cout << std::setw(20) << (cell.substr(0, cell.find('.') + 2) + " (" + error.substr(0, error.find('.') + 2) + "%)");
+        }
+
+        checksum += exact.front();
+        std::cout << "\n";
+    }
+
+    // Keeps the counts from being optimised away
+    std::cout << "(checksum " << static_cast<long long>(checksum) % 1000 << ")" << std::endl;
+
+    return 0;
+}
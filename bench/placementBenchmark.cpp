@@ -0,0 +1,127 @@
+// Measures the scaling of the robust evaluation with the number of threads, for
+// each pinning policy. With the compact policy the threads fill one NUMA node
+// before the next one, with the scatter policy they alternate between the
+// nodes : on a machine of two sockets, the two curves compare one socket with
+// two at the same number of threads.
+//
+// Usage : PLACEMENT_BENCHMARK [levelFile] [populationSize] [numberOfStarts] [generations]
+
+#include "levelCache.hpp"
+#include "robustEvaluator.hpp"
+#include "topology.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Thread counts of the curve : powers of two, the size of a node and the
+    // whole machine
+    std::vector<std::size_t> threadCounts(const CpuTopology& topology)
+    {
+        std::set<std::size_t> counts;
+        for (std::size_t count = 1; count < topology.cpus().size(); count *= 2)
+        {
+            counts.insert(count);
+        }
+        counts.insert(topology.cpus().size() / std::max<std::size_t>(topology.numberOfNodes(), 1));
+        counts.insert(topology.cpus().size());
+        counts.erase(0);
+
+        return std::vector<std::size_t>(counts.begin(), counts.end());
+    }
+
+    std::size_t nodesUsed(const CpuTopology& topology, const std::vector<int>& placement)
+    {
+        std::set<int> nodes;
+        for (int id : placement)
+        {
+            for (const LogicalCpu& cpu : topology.cpus())
+            {
+                if (cpu.id == id)
+                    nodes.insert(cpu.node);
+            }
+        }
+
+        return nodes.size();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string levelFile = argc > 1 ? argv[1] : "resources/data/level_02.txt";
+    const std::size_t populationSize = argc > 2 ? std::stoul(argv[2]) : 2000;
+    const std::size_t numberOfStarts = argc > 3 ? std::stoul(argv[3]) : 8;
+    const std::size_t generations = argc > 4 ? std::stoul(argv[4]) : 10;
+
+    const std::shared_ptr<const PreparedLevel> level = levelCache().load(levelFile);
+    const LevelData& data = level->level.data;
+    const Lander lander(data.position, data.velocity, data.fuel, data.angle, data.thrust);
+
+    utils::RandomEngine engine(42);
+    std::vector<Phenotype> population;
+    for (std::size_t i = 0; i < populationSize; ++i)
+    {
+        population.emplace_back(160, engine);
+    }
+
+    const CpuTopology topology = CpuTopology::read();
+    std::cout << topology.cpus().size() << " logical processors, " << topology.numberOfPackages() << " packages, "
+              << topology.numberOfNodes() << " NUMA nodes\n"
+              << "Rollouts per second (speedup over one thread) and NUMA nodes used\n"
+              << std::left << std::setw(10) << "threads" << std::right;
+    for (PinningPolicy policy : {PinningPolicy::NONE, PinningPolicy::COMPACT, PinningPolicy::SCATTER})
+    {
+        std::cout << std::setw(24) << pinningName(policy);
+    }
+    std::cout << "\n";
+
+    std::vector<double> singleThread(3, 0.0);
+    double checksum = 0.0;
+    for (std::size_t threads : threadCounts(topology))
+    {
+        std::cout << std::left << std::setw(10) << threads << std::right;
+
+        std::size_t column = 0;
+        for (PinningPolicy policy : {PinningPolicy::NONE, PinningPolicy::COMPACT, PinningPolicy::SCATTER})
+        {
+            RobustnessConfig config;
+            config.samples = numberOfStarts;
+            config.threads = threads;
+            config.pinning = policy;
+
+            RobustEvaluator evaluator(config, ControlEncoding(), 1);
+            evaluator.setLevel(lander, level);
+            evaluator.evaluate(population);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t generation = 0; generation < generations; ++generation)
+            {
+                checksum += evaluator.evaluate(population).front().score;
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const double rate = generations * populationSize * evaluator.numberOfStarts() / seconds;
+            if (threads == 1)
+                singleThread[column] = rate;
+
+            const std::size_t nodes = policy == PinningPolicy::NONE ? 0 : nodesUsed(topology, evaluator.placement());
+            const std::string speedup = std::to_string(static_cast<int>(10.0 * rate / singleThread[column] + 0.5) / 10.0);
+            std::cout << std::setw(24) << (std::to_string(static_cast<long long>(rate / 1000.0)) + "k (x"
+                                           + speedup.substr(0, speedup.find('.') + 2) + ")" + (nodes > 0 ? " " + std::to_string(nodes) + "n" : ""));
+            column++;
+        }
+
+        std::cout << "\n";
+    }
+
+    // Keeps the evaluations from being optimised away
+    std::cout << "(checksum " << static_cast<long long>(checksum) % 1000 << ")" << std::endl;
+
+    return 0;
+}
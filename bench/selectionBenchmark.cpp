@@ -0,0 +1,123 @@
+// Measures the cost of the parent selection of a generation against the cost of
+// evaluating it. The reference is the former tournament, which drew its three
+// contestants through utils::uniform, against the precomputed tables of Selector.
+//
+// Usage : SELECTION_BENCHMARK [levelFile]
+
+#include "level.hpp"
+#include "rollout.hpp"
+#include "selection.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // The genetic strategy asks for two parents when crossing over, one otherwise
+    const std::size_t s_selectionsPerIndividual = 2;
+
+    std::size_t legacyTournament(const std::vector<Phenotype>& population, utils::RandomEngine& engine)
+    {
+        std::size_t bestIndex = utils::uniform(engine, 0, population.size() - 1);
+        for (std::size_t i = 1; i < 3; ++i)
+        {
+            const std::size_t candidateIdx = utils::uniform(engine, 0, population.size() - 1);
+            if (population[candidateIdx].score() > population[bestIndex].score())
+            {
+                bestIndex = candidateIdx;
+            }
+        }
+
+        return bestIndex;
+    }
+
+    // Nanoseconds per selection, and share of the time of the evaluation
+    void printCost(double seconds, double evaluation, std::size_t size)
+    {
+        const std::string nanoseconds = std::to_string(static_cast<int>(1e9 * seconds / (s_selectionsPerIndividual * size) + 0.5));
+        const std::string share = std::to_string(static_cast<int>(1000.0 * seconds / evaluation + 0.5) / 10.0);
+
+        std::cout << std::setw(16) << (nanoseconds + " ns " + share.substr(0, share.find('.') + 2) + "%");
+    }
+
+    template <typename Selection>
+    double measure(std::size_t repetitions, Selection&& selection)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < repetitions; ++i)
+        {
+            selection();
+        }
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repetitions;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string levelFile = argc > 1 ? argv[1] : "resources/data/level_02.txt";
+    const Level level = loadLevel(levelFile);
+    const Terrain terrain(level.surfacePoints);
+    const Lander lander(level.data.position, level.data.velocity, level.data.fuel, level.data.angle, level.data.thrust);
+
+    utils::RandomEngine engine(42);
+    std::size_t checksum = 0;
+
+    std::cout << "Cost of one selection, and of the selection phase of a generation in % of its evaluation\n"
+              << std::left << std::setw(12) << "population" << std::right << std::setw(12) << "eval (ms)"
+              << std::setw(16) << "legacy" << std::setw(16) << "tournament" << std::setw(16) << "rank"
+              << std::setw(16) << "sus" << std::setw(16) << "roulette" << "\n";
+
+    for (std::size_t size : {100, 1000, 10000, 100000})
+    {
+        std::vector<Phenotype> population;
+        population.reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            population.emplace_back(160, engine);
+        }
+
+        // Real scores, so that the ranking works on a realistic distribution
+        const auto evaluationStart = std::chrono::steady_clock::now();
+        for (Phenotype& phenotype : population)
+        {
+            phenotype.computeScore(rollout(lander, phenotype, terrain).lander, terrain);
+        }
+        const double evaluation = std::chrono::duration<double>(std::chrono::steady_clock::now() - evaluationStart).count();
+
+        const std::size_t repetitions = std::max<std::size_t>(1, 1000000 / size);
+        std::cout << std::left << std::setw(12) << size << std::right << std::fixed
+                  << std::setw(12) << std::setprecision(2) << 1000.0 * evaluation;
+
+        const double legacy = measure(repetitions, [&] ()
+        {
+            for (std::size_t i = 0; i < s_selectionsPerIndividual * size; ++i)
+                checksum += legacyTournament(population, engine);
+        });
+        printCost(legacy, evaluation, size);
+
+        for (SelectionMethod method : {SelectionMethod::TOURNAMENT, SelectionMethod::RANK,
+                                       SelectionMethod::STOCHASTIC_UNIVERSAL, SelectionMethod::ROULETTE})
+        {
+            Selector selector(method);
+            const double seconds = measure(repetitions, [&] ()
+            {
+                selector.prepare(population);
+                for (std::size_t i = 0; i < s_selectionsPerIndividual * size; ++i)
+                    checksum += selector.select(engine);
+            });
+            printCost(seconds, evaluation, size);
+        }
+
+        std::cout << "\n";
+    }
+
+    // Keeps the selections from being optimised away
+    std::cout << "(checksum " << checksum % 1000 << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+// Compares the search strategies by the number of rollouts they need to find a
+// landing. Every strategy runs with the same seeds on the shipped levels and on
+// randomly generated ones, and stops after a budget of evaluations.
+//
+// Usage : STRATEGY_BENCHMARK [levelDirectory] [numberOfSeeds] [evaluationBudget] [numberOfGeneratedLevels]
+
+#include "level.hpp"
+#include "solver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct StrategyResult
+    {
+        std::size_t solved{0};
+        std::vector<std::size_t> evaluations;
+        double seconds{0.0};
+    };
+
+    StrategyResult runStrategy(StrategyType strategy, const Level& level, std::size_t numberOfSeeds, std::size_t evaluationBudget)
+    {
+        StrategyResult result;
+
+        for (std::size_t seed = 1; seed <= numberOfSeeds; ++seed)
+        {
+            SolverConfig config;
+            config.seed = seed;
+            config.strategy = strategy;
+
+            Solver solver(config);
+            solver.run(level);
+
+            const auto start = std::chrono::steady_clock::now();
+            bool hasLanded = false;
+            while (!hasLanded && solver.numberOfEvaluations() < evaluationBudget)
+            {
+                hasLanded = solver.geneticIteration();
+            }
+            result.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if (hasLanded)
+            {
+                result.solved++;
+                result.evaluations.push_back(solver.numberOfEvaluations());
+            }
+        }
+
+        return result;
+    }
+
+    void printResult(StrategyType strategy, const StrategyResult& result, std::size_t numberOfSeeds)
+    {
+        std::vector<std::size_t> evaluations = result.evaluations;
+        std::sort(evaluations.begin(), evaluations.end());
+
+        std::cout << std::left << std::setw(10) << strategyName(strategy) << std::right
+                  << std::setw(10) << (std::to_string(result.solved) + "/" + std::to_string(numberOfSeeds));
+
+        if (evaluations.empty())
+        {
+            std::cout << std::setw(14) << "-" << std::setw(14) << "-";
+        }
+        else
+        {
+            std::cout << std::setw(14) << evaluations[evaluations.size() / 2] << std::setw(14) << evaluations.back();
+        }
+
+        std::cout << std::fixed << std::setprecision(2) << std::setw(12) << result.seconds / numberOfSeeds << "\n";
+    }
+
+    void runLevel(const std::string& name, const Level& level, std::size_t numberOfSeeds, std::size_t evaluationBudget)
+    {
+        std::cout << "\n" << name << "\n"
+                  << std::left << std::setw(10) << "strategy" << std::right << std::setw(10) << "solved"
+                  << std::setw(14) << "median evals" << std::setw(14) << "max evals" << std::setw(12) << "s / run" << "\n";
+
+        for (StrategyType strategy : {StrategyType::GENETIC, StrategyType::DIFFERENTIAL_EVOLUTION,
+                                      StrategyType::CMA_ES, StrategyType::EVOLUTION_STRATEGY, StrategyType::BEAM_SEARCH})
+        {
+            printResult(strategy, runStrategy(strategy, level, numberOfSeeds, evaluationBudget), numberOfSeeds);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string levelDirectory = argc > 1 ? argv[1] : "resources/data";
+    const std::size_t numberOfSeeds = argc > 2 ? std::stoul(argv[2]) : 5;
+    const std::size_t evaluationBudget = argc > 3 ? std::stoul(argv[3]) : 100000;
+    const std::size_t numberOfGeneratedLevels = argc > 4 ? std::stoul(argv[4]) : 5;
+
+    std::cout << numberOfSeeds << " seeds, budget of " << evaluationBudget << " evaluations per run\n";
+
+    for (int id = 1; id <= 5; ++id)
+    {
+        const std::string fileName = levelDirectory + "/level_0" + std::to_string(id) + ".txt";
+        runLevel(fileName, loadLevel(fileName), numberOfSeeds, evaluationBudget);
+    }
+
+    for (std::size_t i = 1; i <= numberOfGeneratedLevels; ++i)
+    {
+        runLevel("generated level " + std::to_string(i), generateLevel(i), numberOfSeeds, evaluationBudget);
+    }
+
+    return 0;
+}
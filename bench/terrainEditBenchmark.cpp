@@ -0,0 +1,126 @@
+// Measures the in-place edits of a terrain against building it again, and checks
+// after each random edit that the edited terrain answers every query like a
+// terrain built from scratch on the same surface.
+//
+// Usage : TERRAIN_EDIT_BENCHMARK [levelDirectory] [numberOfEdits]
+
+#include "level.hpp"
+#include "random.hpp"
+#include "terrain.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    enum class EditType
+    {
+        MOVE,
+        INSERT,
+        REMOVE
+    };
+
+    // Number of queries which differ from the terrain built from scratch
+    std::size_t countMismatches(const Terrain& edited, const Terrain& reference, utils::RandomEngine& engine)
+    {
+        std::size_t mismatches = 0;
+
+        if (edited.landingLine() != reference.landingLine() || edited.highestGround() != reference.highestGround() ||
+            edited.segmentBounds().size() != reference.segmentBounds().size() || edited.columns().size() != reference.columns().size())
+            return 1;
+
+        for (std::size_t c = 0; c < edited.columns().size(); ++c)
+        {
+            const Terrain::Column& a = edited.columns()[c];
+            const Terrain::Column& b = reference.columns()[c];
+            mismatches += a.firstSegment != b.firstSegment || a.lastSegment != b.lastSegment || a.highestGround != b.highestGround;
+        }
+
+        for (std::size_t i = 0; i < 200; ++i)
+        {
+            const Point2d p{utils::uniform(engine, 0.0, 7000.0), utils::uniform(engine, 0.0, 3000.0)};
+            const Point2d q{p.x + utils::uniform(engine, -150.0, 150.0), p.y + utils::uniform(engine, -150.0, 150.0)};
+
+            const std::optional<Point2d> a = edited.intersection(p, q);
+            const std::optional<Point2d> b = reference.intersection(p, q);
+            mismatches += a.has_value() != b.has_value() || (a && a.value() != b.value());
+            mismatches += edited.distanceToLanding(p) != reference.distanceToLanding(p);
+
+            const Lander lander(p, Point2d{q.x - p.x, q.y - p.y}, 500, 0, 0);
+            mismatches += edited.canReachLanding(lander) != reference.canReachLanding(lander);
+        }
+
+        return mismatches;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string levelDirectory = argc > 1 ? argv[1] : "resources/data";
+    const std::size_t numberOfEdits = argc > 2 ? std::stoul(argv[2]) : 1000;
+
+    utils::RandomEngine engine(42);
+
+    std::cout << "Cost of an edit in place and of building the terrain again, in microseconds\n"
+              << std::left << std::setw(32) << "level" << std::right << std::setw(10) << "edits" << std::setw(10) << "refused"
+              << std::setw(12) << "in place" << std::setw(12) << "rebuild" << std::setw(12) << "mismatches" << "\n";
+
+    for (int id = 1; id <= 5; ++id)
+    {
+        const std::string fileName = levelDirectory + "/level_0" + std::to_string(id) + ".txt";
+        Terrain terrain(loadLevel(fileName).surfacePoints);
+
+        std::size_t refused = 0;
+        std::size_t mismatches = 0;
+        double editSeconds = 0.0;
+        double rebuildSeconds = 0.0;
+
+        for (std::size_t i = 0; i < numberOfEdits; ++i)
+        {
+            const Polyline& surface = terrain.surfacePoints();
+            const EditType type = static_cast<EditType>(utils::uniform(engine, 0, 2));
+
+            // The inner vertices, so that most edits keep the extent of the surface
+            const std::size_t index = utils::uniform(engine, 1, static_cast<int>(surface.size()) - 2);
+            const double left = surface[index - 1].x;
+            const double right = surface[index + 1].x;
+            const Point2d position{std::round(utils::uniform(engine, left, right)), std::round(utils::uniform(engine, 0.0, 2800.0))};
+
+            const Terrain before = terrain;
+            const auto start = std::chrono::steady_clock::now();
+            try
+            {
+                if (type == EditType::MOVE)
+                    terrain.moveVertex(index, position);
+                else if (type == EditType::INSERT)
+                    terrain.insertVertex(index, position);
+                else if (surface.size() > 4)
+                    terrain.removeVertex(index);
+            }
+            catch (const std::runtime_error&)
+            {
+                refused++;
+                mismatches += countMismatches(terrain, before, engine);
+                continue;
+            }
+            editSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const auto rebuildStart = std::chrono::steady_clock::now();
+            const Terrain reference(terrain.surfacePoints());
+            rebuildSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - rebuildStart).count();
+
+            mismatches += countMismatches(terrain, reference, engine);
+        }
+
+        const std::size_t applied = std::max<std::size_t>(1, numberOfEdits - refused);
+        std::cout << std::left << std::setw(32) << fileName << std::right << std::setw(10) << numberOfEdits << std::setw(10) << refused
+                  << std::fixed << std::setprecision(1) << std::setw(12) << 1e6 * editSeconds / applied
+                  << std::setw(12) << 1e6 * rebuildSeconds / applied << std::setw(12) << mismatches << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Measures what the solution store saves on similar levels. Variants of each
+// shipped level are drawn by moving the start of the lander : the first ones
+// are solved from scratch and fill the store, the next ones are solved from
+// scratch and with a warm start from their nearest stored neighbours.
+// It also times a query on a store of many levels.
+//
+// Usage : WARM_START_BENCHMARK [levelDirectory] [numberOfStoredVariants] [numberOfTestedVariants] [maxGenerations] [neighbours]
+
+#include "level.hpp"
+#include "solutionStore.hpp"
+#include "solver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Same default as HEADLESS_SOLVER
+    const float s_warmStartRadius = 0.5f;
+
+
+    // Same level, with the lander moved by up to 300m and 10m/s
+    Level variant(const Level& level, std::uint64_t seed)
+    {
+        utils::RandomEngine engine(seed);
+        Level moved = level;
+        moved.data.position.x = std::clamp(moved.data.position.x + utils::uniform(engine, -300.0, 300.0), 0.0, 6999.0);
+        moved.data.position.y = moved.data.position.y - utils::uniform(engine, 0.0, 200.0);
+        moved.data.velocity.x += utils::uniform(engine, -10.0, 10.0);
+        moved.data.velocity.y += utils::uniform(engine, -10.0, 10.0);
+
+        return moved;
+    }
+
+    // Generations to land, or none within the limit
+    std::optional<std::size_t> solve(const Level& level, std::vector<Phenotype> warmStart, std::size_t maxGenerations, Replay* replay = nullptr)
+    {
+        SolverConfig config;
+        config.seed = 1;
+        config.encoding.maxSteps = 400;
+
+        Solver solver(config);
+        solver.setWarmStart(std::move(warmStart));
+        solver.run(level);
+
+        while (solver.numberOfIterations() < maxGenerations)
+        {
+            if (solver.geneticIteration())
+            {
+                if (replay)
+                    *replay = solver.replay();
+
+                return solver.numberOfIterations();
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::string summary(std::vector<std::size_t> generations, std::size_t runs)
+    {
+        if (generations.empty())
+            return "0/" + std::to_string(runs);
+
+        std::sort(generations.begin(), generations.end());
+        return std::to_string(generations.size()) + "/" + std::to_string(runs) + ", median " + std::to_string(generations[generations.size() / 2]);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string levelDirectory = argc > 1 ? argv[1] : "resources/data";
+    const std::size_t numberOfStoredVariants = argc > 2 ? std::stoul(argv[2]) : 10;
+    const std::size_t numberOfTestedVariants = argc > 3 ? std::stoul(argv[3]) : 10;
+    const std::size_t maxGenerations = argc > 4 ? std::stoul(argv[4]) : 1000;
+    const std::size_t neighbours = argc > 5 ? std::stoul(argv[5]) : 5;
+
+    std::cout << numberOfStoredVariants << " stored and " << numberOfTestedVariants << " tested variants per level, "
+              << neighbours << " neighbours, at most " << maxGenerations << " generations\n"
+              << std::left << std::setw(32) << "level" << std::setw(24) << "cold (landed, gens)" << std::setw(24) << "warm (landed, gens)" << "\n";
+
+    SolutionStore store;
+    for (int id = 1; id <= 5; ++id)
+    {
+        const std::string fileName = levelDirectory + "/level_0" + std::to_string(id) + ".txt";
+        const Level level = loadLevel(fileName);
+
+        for (std::size_t i = 0; i < numberOfStoredVariants; ++i)
+        {
+            const Level stored = variant(level, 1000 * id + i);
+            Replay replay;
+            if (const std::optional<std::size_t> generations = solve(stored, {}, maxGenerations, &replay))
+            {
+                store.add({levelHash(stored), levelFeatures(stored), static_cast<std::uint32_t>(generations.value()), replay.genes});
+            }
+        }
+
+        std::vector<std::size_t> cold;
+        std::vector<std::size_t> warm;
+        for (std::size_t i = 0; i < numberOfTestedVariants; ++i)
+        {
+            const Level tested = variant(level, 1000 * id + 500 + i);
+            if (const std::optional<std::size_t> generations = solve(tested, {}, maxGenerations))
+                cold.push_back(generations.value());
+
+            std::vector<Phenotype> genomes;
+            for (const SolutionNeighbour& neighbour : store.nearest(levelFeatures(tested), neighbours, s_warmStartRadius))
+            {
+                genomes.push_back(warmStartGenome(*neighbour.solution, ControlEncoding{}));
+            }
+            if (const std::optional<std::size_t> generations = solve(tested, std::move(genomes), maxGenerations))
+                warm.push_back(generations.value());
+        }
+
+        std::cout << std::setw(32) << fileName << std::setw(24) << summary(cold, numberOfTestedVariants)
+                  << std::setw(24) << summary(warm, numberOfTestedVariants) << "\n";
+    }
+
+    // Query time on a large store, made of generated levels
+    SolutionStore largeStore;
+    for (std::uint64_t seed = 1; seed <= 10000; ++seed)
+    {
+        const Level level = generateLevel(seed);
+        largeStore.add({levelHash(level), levelFeatures(level), 0, {}});
+    }
+
+    const Level query = generateLevel(123456);
+    const LevelFeatures features = levelFeatures(query);
+    const std::size_t repetitions = 1000;
+    float checksum = 0.0f;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i)
+    {
+        checksum += largeStore.nearest(features, neighbours).front().distance;
+    }
+    const double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+    std::cout << "\nQuery of the " << neighbours << " nearest of " << largeStore.size() << " levels : " << std::fixed
+              << std::setprecision(1) << microseconds << " us (checksum " << checksum / repetitions << ")" << std::endl;
+
+    return 0;
+}
@@ -5,11 +5,23 @@
 #include "resourceIdentifiers.hpp"
 #include "container.hpp"
 #include "levelLoader.hpp"
+#include "performanceHud.hpp"
 #include "simulator.hpp"
+#include "terrainEditor.hpp"
 
 #include <SFML/System/Time.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Text.hpp>
 
+#include <chrono>
+#include <ctime>
+
+// The main loop only wakes up when something can change : it waits for the
+// next event while the simulator is idle, and sleeps the rest of each frame
+// while it runs. Frames are only drawn when their content changed, and the
+// ground and the buttons are drawn from a cached layer, which is rendered
+// again when a level is loaded or edited, or a button is highlighted.
 class Application
 {
 public:
@@ -20,20 +32,33 @@ public:
 
 private:
     void createButtons();
+    void createTerrainEditor();
     void processInput();
+    void handleEvent(const sf::Event& event);
     void update(sf::Time dt);
     void render();
+    void renderStaticLayer();
+    void reportCpuUsage() const;
 
 private:
     static const sf::Time s_timePerFrame;
     
     sf::RenderWindow m_window;
+    sf::RenderTexture m_staticLayer;
+    sf::Sprite m_staticSprite;
+    bool m_isStaticLayerDirty;
+    bool m_needsRedraw;
+    std::clock_t m_cpuStart;
+    std::chrono::steady_clock::time_point m_wallStart;
     sf::Text m_statisticsText;
     TextureHolder m_textures;
     FontHolder m_fonts;
     Container m_container;
     LevelLoader m_levelLoader;
     Simulator m_simulator;
+    PerformanceHud m_performanceHud;
+    TerrainEditor m_terrainEditor;
+    std::size_t m_displayedIterations;
 };
 
 #endif
@@ -0,0 +1,120 @@
+#ifndef BEAM_SEARCH_HPP
+#define BEAM_SEARCH_HPP
+
+#include "lander.hpp"
+#include "levelCache.hpp"
+#include "phenotype.hpp"
+#include "solverConfig.hpp"
+#include "workerPool.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+// Deterministic planner over the states of the lander, the alternative to the
+// population-based strategies. Each expansion applies every action to every
+// state of the beam : an action keeps the same angle and thrust deltas for a
+// few steps, so that plans are per-step genes like any genome. The children are
+// flown with the physics kernel and the collision index of the terrain, and the
+// states already reached by another plan are dropped through a table of their
+// quantized values. Each remaining child is scored like a genome, by a rollout
+// of the PD controller of the seeding to the end of the flight, and the best
+// ones form the next beam. A landing of a rollout is a landing of the plan
+// which led to its state. The rollouts are shared between the threads of a
+// WorkerPool kept for the whole search, each child written to its own slot, so
+// the search does not depend on the scheduling.
+// When the beam dies out, the search starts over with a beam twice as wide, and
+// throws once the widest beam of the configuration died out too.
+class BeamSearch
+{
+public:
+    BeamSearch(const BeamSearchConfig& config, std::size_t maxSteps);
+    virtual ~BeamSearch();
+
+    BeamSearch(const BeamSearch&) = delete;
+    BeamSearch& operator =(const BeamSearch&) = delete;
+
+    void start(const Lander& lander, std::shared_ptr<const PreparedLevel> level);
+    // Expands the beam by one action, returns whether a landing was found
+    bool expand();
+
+    // Plans of the beam finished by their rollouts, as genomes with the scores
+    // of these flights, the landing first once found
+    std::vector<Phenotype> population() const;
+    std::size_t solutionSteps() const noexcept;
+    std::size_t width() const noexcept;
+    std::size_t numberOfRollouts() const noexcept;
+    std::size_t numberOfSteps() const noexcept;
+    std::size_t numberOfCollisionTests() const noexcept;
+
+private:
+    struct Node
+    {
+        Lander lander;
+        std::int32_t parent;
+        std::uint16_t action;
+        std::uint16_t depth;
+        double score;
+    };
+
+    // Quantized values of a state, compared in full so that a collision of
+    // their hash never drops a new state
+    struct StateKey
+    {
+        std::array<std::int64_t, 7> values;
+
+        bool operator==(const StateKey& other) const noexcept { return values == other.values; }
+    };
+
+    struct StateKeyHash
+    {
+        std::size_t operator()(const StateKey& key) const noexcept;
+    };
+
+    struct Child
+    {
+        Node node;
+        bool isFlying{true};
+        bool hasLanded{false};
+        std::size_t landingSteps{0};
+        std::size_t steps{0};
+        std::size_t collisionTests{0};
+        // Commands of the rollout, which finish the plan of the child
+        std::vector<Gene> tail;
+    };
+
+    void restart();
+    Child applyAction(std::int32_t parent, std::uint16_t action) const;
+    void flyRollouts(std::vector<Child>& children);
+    void flyRollout(Child& child) const;
+    std::vector<Gene> plan(std::int32_t node) const;
+    static Gene actionGene(std::uint16_t action) noexcept;
+    static StateKey stateKey(const Lander& lander) noexcept;
+
+private:
+    BeamSearchConfig m_config;
+    std::size_t m_maxSteps;
+    std::size_t m_width;
+    Lander m_lander;
+    std::shared_ptr<const PreparedLevel> m_level;
+
+    std::vector<Node> m_nodes;
+    std::vector<std::int32_t> m_beam;
+    // Rollout of each state of the beam, which its score comes from
+    std::vector<std::vector<Gene>> m_beamTails;
+    std::unordered_set<StateKey, StateKeyHash> m_visitedStates;
+
+    std::vector<Gene> m_solution;
+    std::size_t m_solutionSteps;
+    std::size_t m_numberOfRollouts;
+    std::size_t m_numberOfSteps;
+    std::size_t m_numberOfCollisionTests;
+
+    // Last, so that its threads stop before the data they read is destroyed
+    WorkerPool m_pool;
+};
+
+#endif
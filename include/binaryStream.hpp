@@ -0,0 +1,90 @@
+#ifndef BINARY_STREAM_HPP
+#define BINARY_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Raw reading and writing of trivially copyable values, in the byte order of the host.
+// The sizes read from a stream are checked against the bytes left in it before
+// anything is allocated : a size which cannot fit fails the stream like a
+// truncated read, so that a damaged file never triggers a huge allocation.
+namespace utils
+{
+    // Bytes left to read, or the largest size when the stream cannot tell
+    inline std::uint64_t remainingBytes(std::istream& stream)
+    {
+        const std::istream::pos_type position = stream.tellg();
+        if (position == std::istream::pos_type(-1))
+            return std::numeric_limits<std::uint64_t>::max();
+
+        stream.seekg(0, std::ios::end);
+        const std::istream::pos_type end = stream.tellg();
+        stream.seekg(position);
+
+        return end > position ? static_cast<std::uint64_t>(end - position) : 0;
+    }
+
+    template <typename T>
+    void writeBinary(std::ostream& stream, const T& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T readBinary(std::istream& stream)
+    {
+        T value{};
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return value;
+    }
+
+    // Number of elements of the given size which follows, 0 with the stream
+    // failed when they cannot all be in it
+    template <typename Count>
+    std::uint64_t readBinaryCount(std::istream& stream, std::size_t elementSize)
+    {
+        const std::uint64_t count = readBinary<Count>(stream);
+        if (!stream || (elementSize > 0 && count > remainingBytes(stream) / elementSize))
+        {
+            stream.setstate(std::ios::failbit);
+            return 0;
+        }
+
+        return count;
+    }
+
+    template <typename T>
+    void writeBinaryVector(std::ostream& stream, const std::vector<T>& values)
+    {
+        writeBinary<std::uint64_t>(stream, values.size());
+        stream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    template <typename T>
+    std::vector<T> readBinaryVector(std::istream& stream)
+    {
+        std::vector<T> values(readBinaryCount<std::uint64_t>(stream, sizeof(T)));
+        stream.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
+        return values;
+    }
+
+    inline void writeBinaryString(std::ostream& stream, const std::string& text)
+    {
+        writeBinary<std::uint32_t>(stream, static_cast<std::uint32_t>(text.size()));
+        stream.write(text.data(), text.size());
+    }
+
+    inline std::string readBinaryString(std::istream& stream)
+    {
+        std::string text(readBinaryCount<std::uint32_t>(stream, 1), '\0');
+        stream.read(&text[0], text.size());
+        return text;
+    }
+}
+
+#endif
@@ -24,7 +24,8 @@ public:
     virtual ~Button();
 
     virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
-    void update(sf::Time dt, const sf::RenderWindow& window);
+    // Returns whether the button looks different, so that it is drawn again
+    bool update(sf::Time dt, const sf::RenderWindow& window);
     void handleEvent(const sf::Event& event);
 
     void setText(const std::string& text);
@@ -45,6 +46,7 @@ private:
     sf::Time m_timer;
     std::function<void()> m_pressedCallback;
     bool m_showText;
+    bool m_isHighlighted;
 };
 
 #endif
@@ -0,0 +1,67 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include "phenotype.hpp"
+#include "solverConfig.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Full state of a Solver between two generations, enough to resume it bit-exactly
+struct Checkpoint
+{
+    std::uint64_t levelHash{0};
+    SolverConfig config;
+    std::uint64_t numberOfIterations{0};
+    std::uint64_t numberOfEvaluations{0};
+    std::uint64_t numberOfSteps{0};
+    std::uint64_t numberOfCollisionTests{0};
+    std::string randomEngineState;
+    std::string strategyState;
+    std::vector<Phenotype> population;
+};
+
+// Binary format, in the byte order of the host :
+// magic "MLCP", format version, level hash, configuration, numbers of iterations,
+// evaluations, flown steps and collision tests, random engine state, search
+// strategy state, then for each individual its score and its genes
+void writeCheckpoint(std::ostream& stream, const Checkpoint& checkpoint);
+Checkpoint readCheckpoint(std::istream& stream);
+void saveCheckpoint(const Checkpoint& checkpoint, const std::string& fileName);
+Checkpoint loadCheckpoint(const std::string& fileName);
+
+// Writes checkpoints on a background thread so that the solver never waits for
+// the disk. Only the most recent submitted checkpoint is kept when the writer
+// lags behind, and the file is replaced atomically once fully written.
+class CheckpointWriter
+{
+public:
+    explicit CheckpointWriter(const std::string& fileName);
+    virtual ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator =(const CheckpointWriter&) = delete;
+
+    void submit(Checkpoint checkpoint);
+    const std::string& fileName() const noexcept;
+
+private:
+    void writeLoop();
+
+private:
+    std::string m_fileName;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::optional<Checkpoint> m_pending;
+    bool m_isStopping;
+    std::thread m_thread;
+};
+
+#endif
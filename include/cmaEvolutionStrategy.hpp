@@ -0,0 +1,48 @@
+#ifndef CMA_EVOLUTION_STRATEGY_HPP
+#define CMA_EVOLUTION_STRATEGY_HPP
+
+#include "searchStrategy.hpp"
+
+// Covariance matrix adaptation on the continuous relaxation of the genomes.
+// With 320 coordinates a full covariance would cost a 320x320 eigen
+// decomposition per generation, so the separable variant is used : the
+// covariance is kept diagonal, with the learning rates of Ros & Hansen (2008).
+class CmaEvolutionStrategy : public SearchStrategy
+{
+public:
+    explicit CmaEvolutionStrategy(const SolverConfig& config);
+    virtual ~CmaEvolutionStrategy();
+
+    virtual std::vector<Phenotype> initialPopulation(utils::RandomEngine& engine) override;
+    virtual void nextPopulation(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine) override;
+
+    virtual void saveState(std::ostream& stream) const override;
+    virtual void loadState(std::istream& stream) override;
+
+private:
+    void sample(std::vector<Phenotype>& population, utils::RandomEngine& engine);
+
+private:
+    static double s_initialStepSize;
+
+    std::vector<double> m_weights;
+    double m_effectiveMu;
+    double m_stepSizeLearningRate;
+    double m_stepSizeDamping;
+    double m_pathLearningRate;
+    double m_rankOneLearningRate;
+    double m_rankMuLearningRate;
+    double m_expectedNorm;
+
+    std::vector<double> m_mean;
+    std::vector<double> m_variances;
+    std::vector<double> m_stepSizePath;
+    std::vector<double> m_covariancePath;
+    double m_stepSize;
+    std::uint64_t m_generation;
+
+    // Standard normal samples of the current population
+    std::vector<std::vector<double>> m_samples;
+};
+
+#endif
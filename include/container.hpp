@@ -21,7 +21,8 @@ public:
 
     void pack(const std::shared_ptr<Button>& button);
     void handleEvent(const sf::Event& event, bool isSimulationRunning);
-    void update(sf::Time dt);
+    // Returns whether any button looks different
+    bool update(sf::Time dt);
     virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
 private:
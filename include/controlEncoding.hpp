@@ -0,0 +1,28 @@
+#ifndef CONTROL_ENCODING_HPP
+#define CONTROL_ENCODING_HPP
+
+#include <cstddef>
+
+// How the genes of a genome drive the lander. Each gene is applied for
+// stepsPerGene consecutive steps, so that a genome is a piecewise-linear ramp
+// of the angle and of the thrust. With a maximum number of steps the genomes
+// have a variable length : once its genes run out, the lander holds its last
+// angle and thrust until the maximum is reached.
+struct ControlEncoding
+{
+    std::size_t stepsPerGene{1};
+    // 0 for fixed-length genomes, whose flight stops with their last gene
+    std::size_t maxSteps{0};
+
+    bool isVariableLength() const noexcept
+    {
+        return maxSteps > 0;
+    }
+
+    std::size_t numberOfGenes(std::size_t steps) const noexcept
+    {
+        return (steps + stepsPerGene - 1) / stepsPerGene;
+    }
+};
+
+#endif
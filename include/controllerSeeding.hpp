@@ -0,0 +1,31 @@
+#ifndef CONTROLLER_SEEDING_HPP
+#define CONTROLLER_SEEDING_HPP
+
+#include "controlEncoding.hpp"
+#include "lander.hpp"
+#include "phenotype.hpp"
+#include "random.hpp"
+#include "terrain.hpp"
+
+#include <cstddef>
+
+// Seeding of the initial population with the flights of a closed-loop
+// controller : a PD policy which climbs above the ground between the lander and
+// the landing area, flies over the middle of it, then comes down slowly. Each
+// genome draws its own gains, cruise altitude and speed limits, and the
+// controller is flown once to record its commands as gene deltas. Generation
+// zero then holds flights which already reach the landing area.
+class ControllerSeeder
+{
+public:
+    ControllerSeeder(const ControlEncoding& encoding, std::size_t geneLength);
+    virtual ~ControllerSeeder();
+
+    Phenotype genome(const Lander& lander, const Terrain& terrain, utils::RandomEngine& engine) const;
+
+private:
+    ControlEncoding m_encoding;
+    std::size_t m_numberOfGenes;
+};
+
+#endif
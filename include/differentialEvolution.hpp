@@ -0,0 +1,29 @@
+#ifndef DIFFERENTIAL_EVOLUTION_HPP
+#define DIFFERENTIAL_EVOLUTION_HPP
+
+#include "searchStrategy.hpp"
+
+// DE/rand/1/bin on the continuous relaxation of the genomes : each target
+// vector competes with the trial vector bred for it, the better one survives
+class DifferentialEvolution : public SearchStrategy
+{
+public:
+    explicit DifferentialEvolution(const SolverConfig& config);
+    virtual ~DifferentialEvolution();
+
+    virtual std::vector<Phenotype> initialPopulation(utils::RandomEngine& engine) override;
+    virtual void nextPopulation(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine) override;
+
+    virtual void saveState(std::ostream& stream) const override;
+    virtual void loadState(std::istream& stream) override;
+
+private:
+    static double s_differentialWeight;
+    static double s_crossoverProbability;
+
+    std::vector<std::vector<double>> m_targets;
+    std::vector<double> m_targetScores;
+    std::vector<std::vector<double>> m_trials;
+};
+
+#endif
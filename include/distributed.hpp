@@ -0,0 +1,141 @@
+#ifndef DISTRIBUTED_HPP
+#define DISTRIBUTED_HPP
+
+#include "checkpoint.hpp"
+#include "level.hpp"
+#include "phenotype.hpp"
+#include "replay.hpp"
+#include "socket.hpp"
+#include "solverConfig.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Island model spread over processes. The coordinator owns the state of every
+// island as a checkpoint, and hands islands to the connected workers for a few
+// generations at a time. A worker resumes the headless Solver from the
+// checkpoint, and reports the new checkpoint with its best individuals, which
+// migrate to the next island of the ring. A worker which disconnects only loses
+// its current task : the island goes back to the queue from its last report,
+// unless the island already failed too many times. So does a worker which
+// stalls in the middle of a message, or does not report before its deadline.
+//
+// Every message is a header (type and payload size, 32 and 64 bits) followed by
+// a binary payload in the byte order of the host, so that the processes must
+// run on the same architecture. A larger payload than s_maxPayloadSize is taken
+// for a broken peer.
+constexpr std::uint64_t s_maxPayloadSize = 1ull << 30;
+
+enum class MessageType : std::uint32_t
+{
+    HELLO,
+    TASK,
+    REPORT,
+    STOP
+};
+
+struct IslandTask
+{
+    std::uint32_t island{0};
+    std::uint64_t generations{0};
+    std::uint64_t numberOfMigrants{0};
+    Level level;
+    Checkpoint checkpoint;
+};
+
+struct IslandReport
+{
+    std::uint32_t island{0};
+    bool hasLanded{false};
+    Checkpoint checkpoint;
+    // Best individuals of the last evaluated generation
+    std::vector<Phenotype> migrants;
+    Replay replay;
+};
+
+struct CoordinatorConfig
+{
+    std::string address{"unix:/tmp/mars-lander.socket"};
+    std::size_t numberOfIslands{4};
+    // Generations flown by a worker before reporting
+    std::size_t generationsPerTask{50};
+    std::size_t numberOfMigrants{2};
+    // Generations per island, 0 for unlimited
+    std::size_t maxGenerations{0};
+    // Lost tasks of one island before the run is abandoned
+    std::size_t maxTaskFailures{3};
+    // Seconds without any connected worker before giving up, 0 to wait for ever
+    double workerTimeout{0.0};
+    // Seconds a worker has to report on its task before losing it, 0 for no limit
+    double taskTimeout{600.0};
+};
+
+struct CoordinatorResult
+{
+    std::optional<Replay> replay;
+    std::size_t island{0};
+    std::size_t numberOfEvaluations{0};
+    std::size_t numberOfLostTasks{0};
+};
+
+bool sendMessage(Socket& socket, MessageType type, const std::string& payload);
+std::optional<std::pair<MessageType, std::string>> receiveMessage(Socket& socket);
+
+std::string encodeTask(const IslandTask& task);
+IslandTask decodeTask(const std::string& payload);
+std::string encodeReport(const IslandReport& report);
+IslandReport decodeReport(const std::string& payload);
+
+class Coordinator
+{
+public:
+    // Listens right away, so that workers can connect before run() is called
+    Coordinator(const CoordinatorConfig& config, const SolverConfig& solverConfig);
+    virtual ~Coordinator();
+
+    CoordinatorResult run(const Level& level);
+
+private:
+    struct Island
+    {
+        Checkpoint checkpoint;
+        std::vector<Phenotype> migrants;
+        bool isAssigned{false};
+        std::size_t numberOfFailures{0};
+    };
+
+    struct Worker
+    {
+        Socket socket;
+        std::optional<std::size_t> island;
+        // Time of the report on the island, when there is a task timeout
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+    };
+
+    void assignIslands(const Level& level);
+    void acceptWorker();
+    void greetWorker(std::size_t index);
+    void loseWorker(std::size_t index, CoordinatorResult& result);
+    void loseLateWorkers(CoordinatorResult& result);
+    // Milliseconds until the nearest deadline of a task, -1 without any
+    int nextDeadline() const;
+    bool isFinished(const Island& island) const;
+    void stopWorkers();
+
+private:
+    CoordinatorConfig m_config;
+    SolverConfig m_solverConfig;
+    Socket m_server;
+    std::vector<Island> m_islands;
+    std::vector<Worker> m_workers;
+    // Connected sockets which did not say hello yet
+    std::vector<Socket> m_newSockets;
+};
+
+// Serves the tasks of the coordinator at this address until it stops or goes away
+void runWorker(const std::string& address);
+
+#endif
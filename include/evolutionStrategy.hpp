@@ -0,0 +1,37 @@
+#ifndef EVOLUTION_STRATEGY_HPP
+#define EVOLUTION_STRATEGY_HPP
+
+#include "searchStrategy.hpp"
+
+// (mu + lambda) evolution strategy with self-adaptive step sizes : lambda
+// offspring are bred by gaussian mutation of the mu parents, and the mu best
+// of parents and offspring become the next parents
+class EvolutionStrategy : public SearchStrategy
+{
+public:
+    explicit EvolutionStrategy(const SolverConfig& config);
+    virtual ~EvolutionStrategy();
+
+    virtual std::vector<Phenotype> initialPopulation(utils::RandomEngine& engine) override;
+    virtual void nextPopulation(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine) override;
+
+    virtual void saveState(std::ostream& stream) const override;
+    virtual void loadState(std::istream& stream) override;
+
+private:
+    struct Individual
+    {
+        std::vector<double> point;
+        double stepSize;
+        double score;
+    };
+
+private:
+    static double s_initialStepSize;
+
+    std::size_t m_numberOfParents;
+    std::vector<Individual> m_parents;
+    std::vector<Individual> m_offspring;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef FIXED_POINT_HPP
+#define FIXED_POINT_HPP
+
+#include <cstdint>
+#include <limits>
+
+// Signed fixed-point number with 16 fractional bits stored in 64 bits.
+// Every operation is plain integer arithmetic, so a simulation run with this
+// type gives bit-identical results whatever the compiler or the platform.
+// The integer range is sized for the simulation : coordinates and the
+// products of two coordinates of the 7000m x 3000m zone fit with a large margin.
+class Fixed
+{
+public:
+    static constexpr int s_fractionalBits = 16;
+    static constexpr std::int64_t s_one = std::int64_t(1) << s_fractionalBits;
+
+public:
+    constexpr Fixed() : m_raw(0) {}
+    constexpr Fixed(int value) : m_raw(std::int64_t(value) * s_one) {}
+    constexpr explicit Fixed(double value) : m_raw(static_cast<std::int64_t>(value * s_one + (value < 0.0 ? -0.5 : 0.5))) {}
+
+    static constexpr Fixed fromRaw(std::int64_t raw)
+    {
+        Fixed result;
+        result.m_raw = raw;
+        return result;
+    }
+
+    constexpr std::int64_t raw() const noexcept { return m_raw; }
+    constexpr explicit operator double() const noexcept { return static_cast<double>(m_raw) / s_one; }
+    constexpr explicit operator float() const noexcept { return static_cast<float>(static_cast<double>(*this)); }
+    constexpr explicit operator int() const noexcept { return static_cast<int>(m_raw / s_one); }
+
+    constexpr Fixed operator -() const { return fromRaw(-m_raw); }
+
+    constexpr Fixed& operator +=(Fixed rhs) { m_raw += rhs.m_raw; return *this; }
+    constexpr Fixed& operator -=(Fixed rhs) { m_raw -= rhs.m_raw; return *this; }
+    constexpr Fixed& operator *=(Fixed rhs) { return *this = *this * rhs; }
+    constexpr Fixed& operator /=(Fixed rhs) { return *this = *this / rhs; }
+
+    friend constexpr Fixed operator +(Fixed lhs, Fixed rhs) { return fromRaw(lhs.m_raw + rhs.m_raw); }
+    friend constexpr Fixed operator -(Fixed lhs, Fixed rhs) { return fromRaw(lhs.m_raw - rhs.m_raw); }
+
+    friend constexpr Fixed operator *(Fixed lhs, Fixed rhs)
+    {
+        // Split the left operand so that the intermediate products stay within 64 bits
+        const std::int64_t high = lhs.m_raw >> s_fractionalBits;
+        const std::int64_t low = lhs.m_raw & (s_one - 1);
+
+        return fromRaw(high * rhs.m_raw + ((low * rhs.m_raw) >> s_fractionalBits));
+    }
+
+    friend constexpr Fixed operator /(Fixed lhs, Fixed rhs)
+    {
+        const bool isNegative = (lhs.m_raw < 0) != (rhs.m_raw < 0);
+
+        if (rhs.m_raw == 0)
+        {
+            // Saturate instead of trapping, as a floating point division would give an infinity
+            return fromRaw(isNegative ? std::numeric_limits<std::int64_t>::min() + 1 : std::numeric_limits<std::int64_t>::max());
+        }
+
+        // Long division in two steps so that the numerator is never shifted out of 64 bits
+        const std::uint64_t numerator = magnitude(lhs.m_raw);
+        const std::uint64_t denominator = magnitude(rhs.m_raw);
+        const std::uint64_t quotient = numerator / denominator;
+        const std::uint64_t remainder = numerator % denominator;
+        const std::uint64_t result = (quotient << s_fractionalBits) + (remainder << s_fractionalBits) / denominator;
+
+        return fromRaw(isNegative ? -static_cast<std::int64_t>(result) : static_cast<std::int64_t>(result));
+    }
+
+    friend constexpr bool operator ==(Fixed lhs, Fixed rhs) { return lhs.m_raw == rhs.m_raw; }
+    friend constexpr bool operator !=(Fixed lhs, Fixed rhs) { return lhs.m_raw != rhs.m_raw; }
+    friend constexpr bool operator <(Fixed lhs, Fixed rhs) { return lhs.m_raw < rhs.m_raw; }
+    friend constexpr bool operator >(Fixed lhs, Fixed rhs) { return lhs.m_raw > rhs.m_raw; }
+    friend constexpr bool operator <=(Fixed lhs, Fixed rhs) { return lhs.m_raw <= rhs.m_raw; }
+    friend constexpr bool operator >=(Fixed lhs, Fixed rhs) { return lhs.m_raw >= rhs.m_raw; }
+
+private:
+    static constexpr std::uint64_t magnitude(std::int64_t raw)
+    {
+        return raw < 0 ? static_cast<std::uint64_t>(-raw) : static_cast<std::uint64_t>(raw);
+    }
+
+private:
+    std::int64_t m_raw;
+};
+
+#endif
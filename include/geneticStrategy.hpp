@@ -0,0 +1,37 @@
+#ifndef GENETIC_STRATEGY_HPP
+#define GENETIC_STRATEGY_HPP
+
+#include "niching.hpp"
+#include "searchStrategy.hpp"
+#include "selection.hpp"
+
+// Parent selection, arithmetic crossover and uniform reset mutation, directly
+// on the integer genes. With the fitness sharing, parents are selected on the
+// shared scores. With the deterministic crowding, the children of each pair of
+// parents compete with the closest of them, and the winners breed the next
+// generation in random pairs.
+class GeneticStrategy : public SearchStrategy
+{
+public:
+    explicit GeneticStrategy(const SolverConfig& config);
+    virtual ~GeneticStrategy();
+
+    virtual std::vector<Phenotype> initialPopulation(utils::RandomEngine& engine) override;
+    virtual void nextPopulation(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine) override;
+
+    virtual void saveState(std::ostream& stream) const override;
+    virtual void loadState(std::istream& stream) override;
+
+private:
+    void breedCrowded(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine);
+    Phenotype arithmeticCrossover(const Phenotype& parent1, const Phenotype& parent2, utils::RandomEngine& engine);
+    void mutate(Phenotype& phenotype, utils::RandomEngine& engine);
+
+private:
+    Selector m_selector;
+    Niching m_niching;
+    // Parents of the evaluated generation, for the deterministic crowding
+    std::vector<Phenotype> m_parents;
+};
+
+#endif
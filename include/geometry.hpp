@@ -0,0 +1,113 @@
+#ifndef GEOMETRY_HPP
+#define GEOMETRY_HPP
+
+#include "point.hpp"
+#include "scalar.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace utils
+{
+    constexpr double toRadian(double degree)
+    {
+        return scalar::s_pi / 180.0 * degree;
+    }
+
+    template <typename T>
+    T length(const Point2<T>& a, const Point2<T>& b)
+    {
+        return scalar::sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+    }
+
+    template <typename T>
+    T length(const Point2<T>& a)
+    {
+        return scalar::sqrt(a.x * a.x + a.y * a.y);
+    }
+
+    template <typename T>
+    bool onSegment(const Point2<T>& p, const Point2<T>& q, const Point2<T>& r)
+    {
+        if (q.x <= std::max(p.x, r.x) &&
+            q.x >= std::min(p.x, r.x) &&
+            q.y <= std::max(p.y, r.y) &&
+            q.y >= std::min(p.y, r.y))
+            return true;
+
+        return false;
+    }
+
+    template <typename T>
+    int orientation(const Point2<T>& p, const Point2<T>& q, const Point2<T>& r)
+    {
+        const T val = (q.y - p.y) * (r.x - q.x) - (q.x - p.x) * (r.y - q.y);
+
+        if (val == T(0))
+            return 0; // collinear
+
+        return (val > T(0)) ? 1 : 2; // clock or counterclock wise
+    }
+
+    template <typename T>
+    bool doIntersect(const Point2<T>& p1, const Point2<T>& q1, const Point2<T>& p2, const Point2<T>& q2)
+    {
+        // Find the four orientations needed for general and
+        // special cases
+        const int o1 = orientation(p1, q1, p2);
+        const int o2 = orientation(p1, q1, q2);
+        const int o3 = orientation(p2, q2, p1);
+        const int o4 = orientation(p2, q2, q1);
+
+        // General case
+        if (o1 != o2 && o3 != o4)
+            return true;
+
+        // Special Cases
+        // p1, q1 and p2 are collinear and p2 lies on segment p1q1
+        if (o1 == 0 && onSegment(p1, p2, q1))
+            return true;
+
+        // p1, q1 and q2 are collinear and q2 lies on segment p1q1
+        if (o2 == 0 && onSegment(p1, q2, q1))
+            return true;
+
+        // p2, q2 and p1 are collinear and p1 lies on segment p2q2
+        if (o3 == 0 && onSegment(p2, p1, q2))
+            return true;
+
+        // p2, q2 and q1 are collinear and q1 lies on segment p2q2
+        if (o4 == 0 && onSegment(p2, q1, q2))
+            return true;
+
+        return false;  // Doesn't fall in any of the above cases
+    }
+
+    template <typename T>
+    Point2<T> lineLineIntersection(const Point2<T>& p1, const Point2<T>& p2, const Point2<T>& p3, const Point2<T>& p4)
+    {
+        // Parametric form along p1p2, which keeps the intermediate products
+        // small enough for the fixed-point backend
+        const T denominator = (p1.x - p2.x) * (p3.y - p4.y) - (p1.y - p2.y) * (p3.x - p4.x);
+        const T t = ((p1.x - p3.x) * (p3.y - p4.y) - (p1.y - p3.y) * (p3.x - p4.x)) / denominator;
+
+        return {p1.x + t * (p2.x - p1.x), p1.y + t * (p2.y - p1.y)};
+    }
+
+    // Returns the point where the segment [p, q] first crosses the polyline, if any
+    template <typename T>
+    std::optional<Point2<T>> polylineIntersection(const BasicPolyline<T>& line, const Point2<T>& p, const Point2<T>& q)
+    {
+        for (std::size_t i = 0; i + 1 < line.size(); ++i)
+        {
+            if (doIntersect(line[i], line[i + 1], p, q))
+            {
+                return lineLineIntersection(p, q, line[i], line[i + 1]);
+            }
+        }
+
+        return std::nullopt;
+    }
+}
+
+#endif
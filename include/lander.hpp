@@ -2,41 +2,174 @@
 #define LANDER_HPP
 
 #include "point.hpp"
+#include "scalar.hpp"
 
-#include <SFML/Graphics/Drawable.hpp>
-#include <SFML/Graphics/Transformable.hpp>
-#include <SFML/Graphics/ConvexShape.hpp>
+#include <algorithm>
 
-#include <vector>
-#include <string>
-
-namespace sf { class RenderTarget; }
-
-class Lander : public sf::Drawable, public sf::Transformable
+// Physical model of the lander, templated on the scalar type used for the
+// simulation (float, double or Fixed). Rendering is done by LanderShape.
+// The model is a constexpr kernel without any allocation, so that flights can
+// be checked at compile time : see the reference trajectories of lander.cpp.
+template <typename T>
+class BasicLander
 {
 public:
-    Lander(const Point2d& position, const Point2d& velocity, int fuel, int angle, int thrust);
-    Lander() = default;
-    virtual ~Lander();
+    constexpr BasicLander(const Point2<T>& position, const Point2<T>& velocity, int fuel, int angle, int thrust);
+    constexpr BasicLander() = default;
+
+    constexpr void simulationStep(int angle, int thrust);
+    constexpr bool hasSafelyLanded() const noexcept;
+    constexpr bool canStillLand() const noexcept;
+    // Jumps to the given height under the current acceleration, not constexpr
+    // since it takes a square root
+    void coastTo(const T& height);
+    constexpr const Point2<T>& position() const noexcept;
+    constexpr const Point2<T>& previousPosition() const noexcept;
+    constexpr const Point2<T>& velocity() const noexcept;
+    constexpr int fuel() const noexcept;
+    constexpr int angle() const noexcept;
+    constexpr int thrust() const noexcept;
 
-    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
-    void simulationStep(int angle, int thrust);
-    const Polyline trajectoryLine() const;
-    bool hasSafelyLanded() const noexcept;
-    const Point2d& position() const noexcept;
-    const Point2d& velocity() const noexcept;
+    static constexpr T s_gravity = static_cast<T>(3.711);
 
 private:
-    static double s_gravity;
-
-    sf::ConvexShape m_shape;
-    Point2d m_position;
-    Point2d m_previousPosition;
-    Point2d m_velocity;
-    Point2d m_acceleration;
-    int m_fuel;
-    int m_angle;
-    int m_thrust;
+    Point2<T> m_position;
+    Point2<T> m_previousPosition;
+    Point2<T> m_velocity;
+    Point2<T> m_acceleration;
+    int m_fuel{0};
+    int m_angle{0};
+    int m_thrust{0};
 };
 
+using Lander = BasicLander<double>;
+
+template <typename T>
+constexpr BasicLander<T>::BasicLander(const Point2<T>& position, const Point2<T>& velocity, int fuel, int angle, int thrust)
+    : m_position{position}
+    , m_previousPosition{position}
+    , m_velocity{velocity}
+    , m_acceleration{thrust * scalar::sinDegree<T>(-angle),
+                     thrust * scalar::cosDegree<T>(-angle) - s_gravity}
+    , m_fuel{fuel}
+    , m_angle{angle}
+    , m_thrust{thrust}
+{
+
+}
+
+template <typename T>
+constexpr void BasicLander<T>::simulationStep(int angle, int thrust)
+{
+    m_previousPosition = m_position;
+
+    const int clampedAngle = std::clamp(m_angle + angle, m_angle - 15, m_angle + 15);
+    const int clampedThrust = std::clamp(m_thrust + thrust, m_thrust - 1, m_thrust + 1);
+
+    m_angle = std::clamp(clampedAngle, -90, 90);
+    m_thrust = std::clamp(clampedThrust, 0, 4);
+
+    // The engine cannot burn more than the remaining fuel, and shuts down once the tank is empty
+    m_thrust = std::min(m_thrust, m_fuel);
+    m_fuel -= m_thrust;
+
+    m_acceleration.x = m_thrust * scalar::sinDegree<T>(-m_angle);
+    m_acceleration.y = m_thrust * scalar::cosDegree<T>(-m_angle) - s_gravity;
+
+    m_velocity.x += m_acceleration.x;
+    m_velocity.y += m_acceleration.y;
+
+    m_position.x += m_velocity.x + (static_cast<T>(0.5) * m_acceleration.x);
+    m_position.y += m_velocity.y + (static_cast<T>(0.5) * m_acceleration.y);
+}
+
+template <typename T>
+constexpr bool BasicLander<T>::hasSafelyLanded() const noexcept
+{
+    return (scalar::abs(m_angle)      <= 15 &&
+            scalar::abs(m_velocity.x) <= T(20) &&
+            scalar::abs(m_velocity.y) <= T(40));
+}
+
+template <typename T>
+constexpr bool BasicLander<T>::canStillLand() const noexcept
+{
+    if (m_fuel > 0)
+        return true;
+
+    // Without fuel the flight is ballistic : the horizontal speed is frozen
+    // and the vertical speed can only grow toward the ground
+    return (scalar::abs(m_velocity.x) <= T(20) &&
+            m_velocity.y >= T(-40));
+}
+
+template <typename T>
+void BasicLander<T>::coastTo(const T& height)
+{
+    // With a constant acceleration the steps add up to y + n vy + n² ay / 2,
+    // which is solved for the first step n at the given height
+    const T drop = m_position.y - height;
+    if (drop <= T(0))
+        return;
+
+    T steps{0};
+    if (m_acceleration.y == T(0))
+    {
+        if (m_velocity.y >= T(0))
+            return;
+
+        steps = drop / -m_velocity.y;
+    }
+    else
+    {
+        const T discriminant = m_velocity.y * m_velocity.y - T(2) * m_acceleration.y * drop;
+        if (discriminant < T(0))
+            return;
+
+        steps = (-m_velocity.y - scalar::sqrt(discriminant)) / m_acceleration.y;
+    }
+
+    m_previousPosition = m_position;
+    m_position.x += steps * (m_velocity.x + static_cast<T>(0.5) * steps * m_acceleration.x);
+    m_position.y = height;
+    m_velocity.x += steps * m_acceleration.x;
+    m_velocity.y += steps * m_acceleration.y;
+}
+
+template <typename T>
+constexpr const Point2<T>& BasicLander<T>::position() const noexcept
+{
+    return m_position;
+}
+
+template <typename T>
+constexpr const Point2<T>& BasicLander<T>::previousPosition() const noexcept
+{
+    return m_previousPosition;
+}
+
+template <typename T>
+constexpr const Point2<T>& BasicLander<T>::velocity() const noexcept
+{
+    return m_velocity;
+}
+
+template <typename T>
+constexpr int BasicLander<T>::fuel() const noexcept
+{
+    return m_fuel;
+}
+
+template <typename T>
+constexpr int BasicLander<T>::angle() const noexcept
+{
+    return m_angle;
+}
+
+template <typename T>
+constexpr int BasicLander<T>::thrust() const noexcept
+{
+    return m_thrust;
+}
+
 #endif
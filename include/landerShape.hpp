@@ -0,0 +1,24 @@
+#ifndef LANDER_SHAPE_HPP
+#define LANDER_SHAPE_HPP
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/ConvexShape.hpp>
+
+namespace sf { class RenderTarget; }
+
+// On-screen representation of the lander, kept apart from the physical model
+// so that rollouts only copy the simulation state
+class LanderShape : public sf::Drawable, public sf::Transformable
+{
+public:
+    LanderShape();
+    virtual ~LanderShape();
+
+    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+    sf::ConvexShape m_shape;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef LEVEL_HPP
+#define LEVEL_HPP
+
+#include "point.hpp"
+
+#include <string>
+#include <cstdint>
+
+struct LevelData
+{
+    Point2d position{0.0, 0.0};
+    Point2d velocity{0.0, 0.0};
+    int fuel{0};
+    int angle{0};
+    int thrust{0};
+};
+
+struct Level
+{
+    LevelData data;
+    Polyline surfacePoints;
+};
+
+// Parses a level file : the first line holds the initial state of the lander
+// (xPosition yPosition xVelocity yVelocity fuel angle thrust), the next lines
+// the points of the surface polyline
+Level loadLevel(const std::string& fileName);
+
+// Builds a random level following the rules of the challenge : a 7000m x 3000m
+// zone, a unique flat area at least 1000m wide and the lander above the ground.
+// The same seed always gives the same level with a given standard library.
+Level generateLevel(std::uint64_t seed);
+
+// Returns the flat segment of the surface, where the lander must land
+Polyline findLandingLine(const Polyline& surfacePoints);
+
+// Hash of the content of a level, used to check that saved data belongs to it
+std::uint64_t levelHash(const Level& level);
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef LEVEL_CACHE_HPP
+#define LEVEL_CACHE_HPP
+
+#include "level.hpp"
+#include "terrain.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// A level with everything derived from its surface, built once per level content
+struct PreparedLevel
+{
+    std::uint64_t hash{0};
+    Level level;
+    Terrain terrain;
+};
+
+// Keeps the prepared levels by content hash, so that a level flown many times
+// is only parsed and preprocessed once. With a directory, the prepared levels
+// are also stored on disk and survive the process. The cache can be shared
+// between threads. It holds up to its capacity of levels in memory, the least
+// recently used ones leaving first : a search keeps its own level alive.
+class LevelCache
+{
+public:
+    explicit LevelCache(const std::string& directory = "", std::size_t capacity = 64);
+    virtual ~LevelCache();
+
+    LevelCache(const LevelCache&) = delete;
+    LevelCache& operator =(const LevelCache&) = delete;
+
+    std::shared_ptr<const PreparedLevel> prepare(const Level& level);
+    // Only parses the file again when it was modified since its last load
+    std::shared_ptr<const PreparedLevel> load(const std::string& fileName);
+
+    void setDirectory(const std::string& directory);
+    void setCapacity(std::size_t capacity);
+    void clear();
+    std::size_t size() const;
+    std::size_t numberOfHits() const;
+    std::size_t numberOfMisses() const;
+
+private:
+    std::shared_ptr<const PreparedLevel> find(std::uint64_t hash);
+    std::shared_ptr<const PreparedLevel> build(const Level& level, std::uint64_t hash);
+    std::string cacheFileName(std::uint64_t hash) const;
+    // Both with the mutex held
+    void touch(std::uint64_t hash);
+    void evict();
+
+private:
+    struct LoadedFile
+    {
+        std::filesystem::file_time_type lastWriteTime;
+        std::uint64_t hash;
+    };
+
+    struct CachedLevel
+    {
+        std::shared_ptr<const PreparedLevel> level;
+        std::list<std::uint64_t>::iterator recentUse;
+    };
+
+    mutable std::mutex m_mutex;
+    std::string m_directory;
+    std::size_t m_capacity;
+    std::unordered_map<std::uint64_t, CachedLevel> m_levels;
+    // Hashes of the levels, the most recently used first
+    std::list<std::uint64_t> m_recentUses;
+    std::unordered_map<std::string, LoadedFile> m_files;
+    std::size_t m_numberOfHits;
+    std::size_t m_numberOfMisses;
+};
+
+// Cache shared by the whole program
+LevelCache& levelCache();
+
+// Binary format of the prepared levels stored on disk, in the byte order of the host :
+// magic "MLPL", format version, level hash, initial state of the lander, then the terrain
+void savePreparedLevel(const PreparedLevel& preparedLevel, const std::string& fileName);
+PreparedLevel loadPreparedLevel(const std::string& fileName);
+
+#endif
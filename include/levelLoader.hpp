@@ -1,22 +1,14 @@
 #ifndef LEVEL_LOADER_HPP
 #define LEVEL_LOADER_HPP
 
+#include "levelCache.hpp"
 #include "point.hpp"
 
 #include <SFML/Graphics.hpp>
 
-#include <vector>
+#include <memory>
 #include <string>
 
-struct LevelData
-{
-    Point2d position{0.0, 0.0};
-    Point2d velocity{0.0, 0.0};
-    int fuel{0};
-    int angle{0};
-    int thrust{0};
-};
-
 class LevelLoader
 {
 public:
@@ -24,18 +16,17 @@ public:
     virtual ~LevelLoader();
     
     void load(const std::string& levelName);
-    void render(sf::RenderWindow& window);
+    // Shows another version of the level, such as an edited one
+    void setLevel(std::shared_ptr<const PreparedLevel> level);
+    void render(sf::RenderTarget& target);
 
     const Polyline& surfacePoints() noexcept;
     const LevelData& levelData() noexcept;
+    std::shared_ptr<const PreparedLevel> preparedLevel() const noexcept;
 
 private:
-    const std::vector<std::string> splitText(const std::string& text);
-
-private:
-    LevelData       m_levelData;
+    std::shared_ptr<const PreparedLevel> m_preparedLevel;
     sf::VertexArray m_groundLines;
-    Polyline        m_surfacePoints;
 };
 
 #endif
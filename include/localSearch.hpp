@@ -0,0 +1,49 @@
+#ifndef LOCAL_SEARCH_HPP
+#define LOCAL_SEARCH_HPP
+
+#include "controlEncoding.hpp"
+#include "lander.hpp"
+#include "phenotype.hpp"
+#include "rollout.hpp"
+#include "solverConfig.hpp"
+#include "terrain.hpp"
+
+#include <cstddef>
+#include <optional>
+
+struct LocalSearchResult
+{
+    std::size_t evaluations{0};
+    // Length of the flight, when the refined genome lands
+    std::optional<std::size_t> landingSteps;
+};
+
+// Refinement of the near misses : individuals which reach the landing area but
+// fail the landing by a few m/s or degrees. A coordinate descent goes over the
+// last genes flown before the impact, trying a few angle and thrust deltas for
+// each, and keeps every change which brings the touchdown closer to a safe one.
+// The state of the lander at the start of each of these genes is kept, so that
+// a trial only flies again the steps after the gene it changes. No random number is drawn, so that
+// the search stays reproducible from a checkpoint.
+class LocalSearch
+{
+public:
+    LocalSearch(const LocalSearchConfig& config, const ControlEncoding& encoding);
+    virtual ~LocalSearch();
+
+    // Improves the phenotype in place and updates its score, within the budget
+    // of evaluations of the configuration. Individuals which miss the landing
+    // area are left untouched.
+    LocalSearchResult refine(Phenotype& phenotype, const Lander& lander, const Terrain& terrain) const;
+
+private:
+    // Lower is better, 0 is a landing
+    double landingError(const RolloutResult<double>& result, const Terrain& terrain) const;
+    bool isOnLandingArea(const RolloutResult<double>& result, const Terrain& terrain) const;
+
+private:
+    LocalSearchConfig m_config;
+    ControlEncoding m_encoding;
+};
+
+#endif
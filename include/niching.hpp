@@ -0,0 +1,63 @@
+#ifndef NICHING_HPP
+#define NICHING_HPP
+
+#include "phenotype.hpp"
+#include "random.hpp"
+#include "solverConfig.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Distances between genomes, for the niching modes of the genetic strategy.
+// A genome is packed into one unsigned byte per coordinate, the thrust deltas
+// scaled to weigh like the angle deltas, and the missing genes of the shorter
+// genomes are the zero deltas the lander flies once the genes run out. The
+// distance is then a sum of absolute differences over bytes, a loop which the
+// compiler turns into a few vector instructions per 16 coordinates.
+//
+// The fitness sharing divides the score of each genome, taken above the worst
+// one, by the size of its niche : the sum over the population of
+// 1 - distance / radius for the genomes closer than the radius. It is exact in
+// O(N²) distances, or estimated from a random sample of the population or from
+// the genomes which fall in the same bucket of a locality-sensitive hash.
+class Niching
+{
+public:
+    explicit Niching(const NichingConfig& config);
+    virtual ~Niching();
+
+    // Scores of the population after the fitness sharing
+    const std::vector<double>& sharedScores(const std::vector<Phenotype>& population, utils::RandomEngine& engine);
+
+    // Mean difference per coordinate between two genomes
+    static double distance(const Phenotype& a, const Phenotype& b);
+
+private:
+    void pack(const std::vector<Phenotype>& population);
+    std::uint32_t packedDistance(std::size_t a, std::size_t b) const noexcept;
+    double sharing(std::uint32_t distance) const noexcept;
+
+    void countExactly();
+    void countSampled(utils::RandomEngine& engine);
+    void countHashed(utils::RandomEngine& engine);
+
+private:
+    NichingConfig m_config;
+    // Packed genomes, m_stride bytes each
+    std::vector<std::uint8_t> m_keys;
+    std::size_t m_stride;
+    std::size_t m_size;
+    // Radius in packed distance units
+    double m_radius;
+    std::vector<double> m_nicheSizes;
+    std::vector<double> m_sharedScores;
+};
+
+NichingMethod nichingFromName(const std::string& name);
+std::string nichingName(NichingMethod method);
+NichingApproximation nichingApproximationFromName(const std::string& name);
+std::string nichingApproximationName(NichingApproximation approximation);
+
+#endif
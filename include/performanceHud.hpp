@@ -0,0 +1,86 @@
+#ifndef PERFORMANCE_HUD_HPP
+#define PERFORMANCE_HUD_HPP
+
+#include "simulator.hpp"
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+
+namespace sf { class RenderTarget; class RenderStates; }
+
+// Overlay of the performance figures of the search : generations, lander steps
+// and collision tests per second, frame time, solver time per generation,
+// processor usage over the hardware threads, and a sparkline of the best score
+// of the last generations. The rates are measured over a refresh period, and a
+// value is only formatted again, into a fixed buffer, when it changed. The
+// sparkline is a ring of vertices : a generation writes a single vertex, and
+// the ring is drawn in two pieces, each moved to its place by a transform.
+class PerformanceHud : public sf::Drawable, public sf::Transformable, private sf::NonCopyable
+{
+public:
+    PerformanceHud();
+    virtual ~PerformanceHud();
+
+    void setFont(const sf::Font& font);
+    void toggle() noexcept;
+    bool isVisible() const noexcept;
+
+    void recordFrame(sf::Time frameTime) noexcept;
+    // Returns whether the overlay changed, while it is visible
+    bool update(sf::Time dt, const Simulator& simulator);
+    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+    enum Line
+    {
+        GENERATIONS,
+        STEPS,
+        COLLISION_TESTS,
+        FRAME_TIME,
+        GENERATION_TIME,
+        CPU_USAGE,
+        NUMBER_OF_LINES
+    };
+
+    bool setValue(Line line, const char* format, double value);
+    bool recordScore(const Simulator& simulator);
+    void refresh(const Simulator& simulator);
+
+private:
+    static const sf::Time s_refreshPeriod;
+    static const std::size_t s_sparklineLength = 120;
+
+    bool m_isVisible;
+    sf::RectangleShape m_background;
+    std::array<sf::Text, NUMBER_OF_LINES> m_labels;
+    std::array<sf::Text, NUMBER_OF_LINES> m_values;
+    std::array<std::array<char, 32>, NUMBER_OF_LINES> m_formattedValues;
+
+    std::array<sf::Vertex, s_sparklineLength> m_sparkline;
+    std::size_t m_sparklineHead;
+    std::size_t m_sparklineSize;
+    std::size_t m_recordedIterations;
+
+    // Counters at the start of the refresh period
+    bool m_hasBaseline;
+    sf::Time m_elapsedTime;
+    sf::Time m_longestFrame;
+    std::size_t m_iterations;
+    std::size_t m_steps;
+    std::size_t m_collisionTests;
+    std::clock_t m_cpuTime;
+    std::chrono::steady_clock::time_point m_wallTime;
+};
+
+#endif
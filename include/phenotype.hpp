@@ -2,32 +2,75 @@
 #define PHENOTYPE_HPP
 
 #include "point.hpp"
+#include "geometry.hpp"
+#include "lander.hpp"
+#include "random.hpp"
+#include "terrain.hpp"
 
 #include <vector>
+#include <cstdint>
 
-class Lander;
-
+// The lander clamps the angle delta to [-15, 15] and the thrust delta to [-1, 1],
+// and mutations draw angles in [-90, 90] : one signed byte per command is enough,
+// which keeps large populations in cache
 struct Gene
 {
-    int angle;
-    int thrust;
+    std::int8_t angle;
+    std::int8_t thrust;
 };
 
+static_assert(sizeof(Gene) == 2, "A gene must stay packed in two bytes");
+
 class Phenotype 
 {
 public:
     Phenotype(std::size_t geneLength = 160);
+    Phenotype(std::size_t geneLength, utils::RandomEngine& engine);
+    Phenotype(std::vector<Gene> genes, double score);
     virtual ~Phenotype();
 
-    void computeScore(const Lander& lander, const Polyline& landingLine);
+    template <typename T>
+    void computeScore(const BasicLander<T>& lander, const BasicTerrain<T>& terrain);
     Gene& gene(std::size_t id);
     const Gene& gene(std::size_t id) const noexcept;
+    std::vector<Gene>& genes() noexcept;
+    const std::vector<Gene>& genes() const noexcept;
     const std::size_t size() const noexcept;
     const double score() const noexcept;
+    void setScore(double score) noexcept;
 
 private:
     std::vector<Gene> m_genes;
     double m_score;
 };
 
+template <typename T>
+void Phenotype::computeScore(const BasicLander<T>& lander, const BasicTerrain<T>& terrain)
+{
+    const BasicPolyline<T>& landingLine = terrain.landingLine();
+    const Point2<T>& velocity = lander.velocity();
+
+    if (!utils::doIntersect(lander.previousPosition(), lander.position(), landingLine[0], landingLine[1]))
+    {
+        // Around the obstacles, so that crashing against a cliff in the way does
+        // not look close to the landing area
+        const T distanceToTarget = terrain.distanceToLanding(lander.position());
+
+        const T distancePenality = distanceToTarget / T(100);
+        const T velocityPenality = utils::length(velocity) / T(175);
+
+        m_score = 100.0 - scalar::toDouble(distancePenality) - scalar::toDouble(velocityPenality);
+    }
+    else if (T(20) < scalar::abs(velocity.x) || T(40) < scalar::abs(velocity.y))
+    {
+        const T penality = scalar::abs(velocity.x) / T(250) + scalar::abs(velocity.y) / T(250);
+
+        m_score = 100.0 - scalar::toDouble(penality);
+    }
+    else
+    {
+        m_score = 100.0;
+    }
+}
+
 #endif
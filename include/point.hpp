@@ -6,23 +6,23 @@
 template <typename T>
 struct Point2
 {
-    Point2();
-    Point2(T X, T Y);
+    constexpr Point2();
+    constexpr Point2(T X, T Y);
 
     T x;
     T y;
 };
 
 template <typename T>
-Point2<T>::Point2() :
-    x(0.0),
-    y(0.0)
+constexpr Point2<T>::Point2() :
+    x(0),
+    y(0)
 {
 
 }
 
 template <typename T>
-Point2<T>::Point2(T X, T Y) :
+constexpr Point2<T>::Point2(T X, T Y) :
     x(X),
     y(Y)
 {
@@ -30,13 +30,51 @@ Point2<T>::Point2(T X, T Y) :
 }
 
 template <typename T>
-Point2<T>& operator +=(Point2<T>& lhs, const Point2<T>& rhs)
+constexpr Point2<T>& operator +=(Point2<T>& lhs, const Point2<T>& rhs)
 {
     lhs.x += rhs.x;
     lhs.y += rhs.y;
+
+    return lhs;
+}
+
+template <typename T>
+constexpr bool operator ==(const Point2<T>& lhs, const Point2<T>& rhs)
+{
+    return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+template <typename T>
+constexpr bool operator !=(const Point2<T>& lhs, const Point2<T>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename U, typename T>
+Point2<U> pointCast(const Point2<T>& point)
+{
+    return {static_cast<U>(point.x), static_cast<U>(point.y)};
+}
+
+template <typename T>
+using BasicPolyline = std::vector<Point2<T>>;
+
+template <typename U, typename T>
+BasicPolyline<U> polylineCast(const BasicPolyline<T>& line)
+{
+    BasicPolyline<U> result;
+    result.reserve(line.size());
+
+    for (const Point2<T>& point : line)
+    {
+        result.push_back(pointCast<U>(point));
+    }
+
+    return result;
 }
 
 using Point2d = Point2<double>;
-using Polyline = std::vector<Point2d>;
+using Point2f = Point2<float>;
+using Polyline = BasicPolyline<double>;
 
 #endif
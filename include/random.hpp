@@ -0,0 +1,21 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <random>
+
+namespace utils
+{
+    using RandomEngine = std::default_random_engine;
+
+    // Draws from the engine shared by the whole program
+    int uniform(int inclusiveMin, int inclusiveMax);
+    double uniform(double inclusiveMin, double exclusiveMax);
+
+    // Draws from a given engine, for components which own their random state
+    int uniform(RandomEngine& engine, int inclusiveMin, int inclusiveMax);
+    double uniform(RandomEngine& engine, double inclusiveMin, double exclusiveMax);
+
+    unsigned long timeSeed();
+}
+
+#endif
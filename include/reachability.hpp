@@ -0,0 +1,78 @@
+#ifndef REACHABILITY_HPP
+#define REACHABILITY_HPP
+
+#include "binaryStream.hpp"
+#include "lander.hpp"
+#include "scalar.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+// Feasibility table of a level, to stop the rollouts which can no longer land.
+// It is indexed by the height above the landing area and the vertical speed,
+// and holds the highest horizontal speed from which a touchdown on the landing
+// altitude within the speed limits can still be reached.
+//
+// It is computed by value iteration on a relaxation of the lander : the angle
+// and the thrust can take any of their values at each step, the fuel is not
+// counted and the only obstacle is the lowest ground of the level. Each cell
+// is mapped as a whole, and takes the best value of the cells it can reach, so
+// that the table never rejects a state from which the real lander could land.
+class ReachabilityTable
+{
+public:
+    ReachabilityTable() = default;
+
+    void build(double landingHeight, double lowestGround, double zoneTop);
+
+    template <typename T>
+    bool canReachLanding(const BasicLander<T>& lander) const noexcept;
+
+    void save(std::ostream& stream) const;
+    static ReachabilityTable load(std::istream& stream);
+
+private:
+    float maximumValue(double lowHeight, double highHeight, double lowSpeed, double highSpeed) const noexcept;
+
+private:
+    static constexpr double s_heightStep = 20.0;
+    static constexpr double s_speedStep = 4.0;
+    // Below it, braking before the ground takes more than the whole zone
+    static constexpr double s_minimumSpeed = -120.0;
+    static constexpr double s_maximumSpeed = 100.0;
+
+    double m_landingHeight{0.0};
+    // Heights relative to the landing area
+    double m_floor{0.0};
+    double m_top{0.0};
+    std::uint32_t m_rows{0};
+    std::uint32_t m_columns{0};
+    // Row after row of heights, infinite where any horizontal speed can be stopped
+    std::vector<float> m_values;
+};
+
+template <typename T>
+bool ReachabilityTable::canReachLanding(const BasicLander<T>& lander) const noexcept
+{
+    if (m_values.empty())
+        return true;
+
+    const double height = scalar::toDouble(lander.position().y) - m_landingHeight;
+    const double verticalSpeed = scalar::toDouble(lander.velocity().y);
+
+    // Out of the table : the collision tests decide
+    if (height < m_floor || height >= m_top || verticalSpeed >= s_maximumSpeed)
+        return true;
+
+    if (verticalSpeed < s_minimumSpeed)
+        return false;
+
+    const std::uint32_t row = static_cast<std::uint32_t>((height - m_floor) * (1.0 / s_heightStep));
+    const std::uint32_t column = static_cast<std::uint32_t>((verticalSpeed - s_minimumSpeed) * (1.0 / s_speedStep));
+
+    return scalar::abs(scalar::toDouble(lander.velocity().x)) <= m_values[row * m_columns + column];
+}
+
+#endif
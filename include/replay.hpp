@@ -0,0 +1,24 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include "phenotype.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Control sequence of a landing, with what is needed to fly it again :
+// the hash of the level it was found on and the seed of the search
+struct Replay
+{
+    std::uint64_t levelHash{0};
+    std::uint64_t seed{0};
+    std::vector<Gene> genes;
+};
+
+// Binary format, in the byte order of the host :
+// magic "MLRP", format version, level hash, seed, number of genes, genes
+void saveReplay(const Replay& replay, const std::string& fileName);
+Replay loadReplay(const std::string& fileName);
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef ROBUST_EVALUATOR_HPP
+#define ROBUST_EVALUATOR_HPP
+
+#include "controlEncoding.hpp"
+#include "lander.hpp"
+#include "levelCache.hpp"
+#include "phenotype.hpp"
+#include "solverConfig.hpp"
+#include "workerPool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct RobustEvaluation
+{
+    double score{0.0};
+    std::size_t numberOfLandings{0};
+    bool hasNominalLanding{false};
+    std::size_t nominalSteps{0};
+    // Longest flight over the starts
+    std::size_t steps{0};
+    // Work of the rollouts of all the starts
+    std::size_t flownSteps{0};
+    std::size_t collisionTests{0};
+};
+
+// Flies every genome of a generation from the nominal start of the level and
+// from perturbed ones. The perturbed starts are drawn once per level from the
+// seed, so that all the genomes of all the generations face the same ones and
+// their scores stay comparable. The genomes are shared between the threads of
+// a WorkerPool kept for the whole search ; each genome is flown from all the
+// starts by the same thread, which keeps its results independent of the
+// scheduling. The threads can be pinned to the processors, the calling thread
+// then only waits for the pool. Each one flies from its own copy of the
+// terrain and of the starts, made by the thread itself, so that the pages it
+// reads are first touched on its NUMA node : only the genomes and the
+// evaluations cross the nodes.
+class RobustEvaluator
+{
+public:
+    RobustEvaluator(const RobustnessConfig& config, const ControlEncoding& encoding, std::uint64_t seed);
+    virtual ~RobustEvaluator();
+
+    RobustEvaluator(const RobustEvaluator&) = delete;
+    RobustEvaluator& operator =(const RobustEvaluator&) = delete;
+
+    void setLevel(const Lander& lander, std::shared_ptr<const PreparedLevel> level);
+    const std::vector<RobustEvaluation>& evaluate(const std::vector<Phenotype>& population);
+
+    // Whether an evaluation counts as a landing of the genome
+    bool isLanding(const RobustEvaluation& evaluation) const noexcept;
+    std::size_t numberOfStarts() const noexcept;
+    // Processor of each worker, empty when not pinned
+    const std::vector<int>& placement() const noexcept;
+
+private:
+    // Data read by a thread, allocated by it
+    struct Arena
+    {
+        std::size_t levelVersion{0};
+        Terrain terrain;
+        std::vector<Lander> starts;
+        std::vector<double> scores;
+    };
+
+    void evaluateShare(std::size_t worker);
+    RobustEvaluation evaluateGenome(const Phenotype& phenotype, Arena& arena) const;
+
+private:
+    RobustnessConfig m_config;
+    ControlEncoding m_encoding;
+    std::uint64_t m_seed;
+    std::shared_ptr<const PreparedLevel> m_level;
+    std::vector<Lander> m_starts;
+    std::size_t m_quantileIndex;
+    std::size_t m_levelVersion;
+    std::vector<std::unique_ptr<Arena>> m_arenas;
+
+    const std::vector<Phenotype>* m_population;
+    std::vector<RobustEvaluation> m_evaluations;
+    std::atomic<std::size_t> m_nextGenome;
+
+    // Last, so that its threads stop before the data they read is destroyed
+    WorkerPool m_pool;
+};
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef ROLLOUT_HPP
+#define ROLLOUT_HPP
+
+#include "controlEncoding.hpp"
+#include "phenotype.hpp"
+#include "lander.hpp"
+#include "point.hpp"
+#include "terrain.hpp"
+
+#include <optional>
+#include <utility>
+
+template <typename T>
+struct RolloutResult
+{
+    BasicLander<T> lander;
+    std::optional<Point2<T>> impact;
+    std::size_t steps{0};
+    // Segments of the surface exactly tested against the steps
+    std::size_t collisionTests{0};
+    bool hasLanded{false};
+};
+
+// Steps between two lookups of the reachability table
+inline constexpr std::size_t s_reachabilityInterval = 4;
+
+// Command applied at a step of the flight
+inline Gene geneAtStep(const Phenotype& phenotype, const ControlEncoding& encoding, std::size_t step)
+{
+    const std::size_t geneIndex = encoding.stepsPerGene == 1 ? step : step / encoding.stepsPerGene;
+    return geneIndex < phenotype.size() ? phenotype.gene(geneIndex) : Gene{0, 0};
+}
+
+// Flies the lander with the genes of the phenotype until it crosses the surface,
+// runs out of steps or can no longer land, according to its fuel or to the
+// reachability table of the terrain. The lander is the state of the flight
+// at firstStep, so that only the tail of a genome is flown again when its
+// beginning did not change. The callback receives every point of the trajectory
+// after the starting position, the last one being the impact point.
+template <typename T, typename StepCallback>
+RolloutResult<T> rolloutFrom(const BasicLander<T>& lander, std::size_t firstStep, const Phenotype& phenotype,
+                             const BasicTerrain<T>& terrain, const ControlEncoding& encoding, StepCallback&& onStep)
+{
+    RolloutResult<T> result{lander, std::nullopt, firstStep};
+    const BasicPolyline<T>& landingLine = terrain.landingLine();
+
+    const std::size_t numberOfSteps = encoding.isVariableLength() ? encoding.maxSteps : phenotype.size() * encoding.stepsPerGene;
+    for (std::size_t i = firstStep; i < numberOfSteps; ++i)
+    {
+        const Gene gene = geneAtStep(phenotype, encoding, i);
+
+        result.lander.simulationStep(gene.angle, gene.thrust);
+        result.steps++;
+
+        result.impact = terrain.intersection(result.lander.previousPosition(), result.lander.position(), result.collisionTests);
+        if (result.impact)
+        {
+            onStep(result.impact.value());
+
+            result.hasLanded = result.impact.value().x >= landingLine[0].x &&
+                               result.impact.value().x <= landingLine[1].x &&
+                               result.lander.hasSafelyLanded();
+            break;
+        }
+
+        onStep(result.lander.position());
+
+        // The outcome is already known, skip the remaining steps
+        if (!result.lander.canStillLand())
+            break;
+
+        // The reachability table is only looked up every few steps, a doomed
+        // flight stays doomed. It is scored where it would reach the altitude
+        // of the landing area, unless the ground is in the way.
+        if (i % s_reachabilityInterval == 0 && !terrain.canReachLanding(result.lander))
+        {
+            BasicLander<T> coasted = result.lander;
+            coasted.coastTo(landingLine[0].y);
+
+            const std::optional<Point2<T>> impact = terrain.intersection(coasted.previousPosition(), coasted.position(), result.collisionTests);
+            if (!impact || (impact.value().x >= landingLine[0].x && impact.value().x <= landingLine[1].x))
+            {
+                result.lander = coasted;
+            }
+            break;
+        }
+    }
+
+    return result;
+}
+
+template <typename T, typename StepCallback>
+RolloutResult<T> rollout(const BasicLander<T>& lander, const Phenotype& phenotype,
+                         const BasicTerrain<T>& terrain, const ControlEncoding& encoding, StepCallback&& onStep)
+{
+    return rolloutFrom(lander, 0, phenotype, terrain, encoding, std::forward<StepCallback>(onStep));
+}
+
+template <typename T, typename StepCallback>
+RolloutResult<T> rollout(const BasicLander<T>& lander, const Phenotype& phenotype,
+                         const BasicTerrain<T>& terrain, StepCallback&& onStep)
+{
+    return rollout(lander, phenotype, terrain, ControlEncoding(), std::forward<StepCallback>(onStep));
+}
+
+template <typename T>
+RolloutResult<T> rollout(const BasicLander<T>& lander, const Phenotype& phenotype,
+                         const BasicTerrain<T>& terrain)
+{
+    return rollout(lander, phenotype, terrain, [] (const Point2<T>&) {});
+}
+
+#endif
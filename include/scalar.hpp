@@ -0,0 +1,129 @@
+#ifndef SCALAR_HPP
+#define SCALAR_HPP
+
+#include "fixedPoint.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// Math functions shared by the scalar types the simulation can run on :
+// float, double and Fixed.
+namespace scalar
+{
+    constexpr double s_pi = 3.14159265358979323846;
+
+    inline float sqrt(float value) { return std::sqrt(value); }
+    inline double sqrt(double value) { return std::sqrt(value); }
+
+    constexpr int abs(int value) { return value < 0 ? -value : value; }
+    constexpr float abs(float value) { return value < 0.0f ? -value : value; }
+    constexpr double abs(double value) { return value < 0.0 ? -value : value; }
+
+    constexpr double toDouble(float value) { return static_cast<double>(value); }
+    constexpr double toDouble(double value) { return value; }
+
+    constexpr Fixed abs(Fixed value) { return value < Fixed() ? -value : value; }
+    constexpr double toDouble(Fixed value) { return static_cast<double>(value); }
+
+    constexpr Fixed sqrt(Fixed value)
+    {
+        if (value <= Fixed())
+            return Fixed();
+
+        // Bitwise integer square root of raw * 2^16, which is the raw value of the result
+        std::uint64_t remainder = static_cast<std::uint64_t>(value.raw()) << Fixed::s_fractionalBits;
+        std::uint64_t result = 0;
+        std::uint64_t bit = std::uint64_t(1) << 62;
+
+        while (bit > remainder)
+            bit >>= 2;
+
+        while (bit != 0)
+        {
+            if (remainder >= result + bit)
+            {
+                remainder -= result + bit;
+                result = (result >> 1) + bit;
+            }
+            else
+            {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+
+        return Fixed::fromRaw(static_cast<std::int64_t>(result));
+    }
+
+    // The trigonometric tables must not depend on the libm of the platform, and
+    // must be available at compile time : they are computed from Taylor series,
+    // whose basic floating point operations are correctly rounded by every
+    // conforming compiler
+    constexpr double taylorSine(double radian)
+    {
+        double term = radian;
+        double result = radian;
+
+        for (int n = 1; n < 12; ++n)
+        {
+            term *= -radian * radian / ((2 * n) * (2 * n + 1));
+            result += term;
+        }
+
+        return result;
+    }
+
+    constexpr double taylorCosine(double radian)
+    {
+        double term = 1.0;
+        double result = 1.0;
+
+        for (int n = 1; n < 12; ++n)
+        {
+            term *= -radian * radian / ((2 * n - 1) * (2 * n));
+            result += term;
+        }
+
+        return result;
+    }
+
+    // The lander angle is always an integer in [-90, 90], so the trigonometric
+    // functions are tabulated once instead of being evaluated at each step
+    template <typename T>
+    struct TrigonometryTable
+    {
+        static constexpr int s_minDegree = -90;
+        static constexpr int s_maxDegree = 90;
+
+        constexpr TrigonometryTable() : sine(), cosine()
+        {
+            for (int degree = s_minDegree; degree <= s_maxDegree; ++degree)
+            {
+                const double radian = s_pi / 180.0 * degree;
+                sine[degree - s_minDegree] = static_cast<T>(taylorSine(radian));
+                cosine[degree - s_minDegree] = static_cast<T>(taylorCosine(radian));
+            }
+        }
+
+        std::array<T, s_maxDegree - s_minDegree + 1> sine;
+        std::array<T, s_maxDegree - s_minDegree + 1> cosine;
+    };
+
+    template <typename T>
+    inline constexpr TrigonometryTable<T> s_trigonometryTable{};
+
+    template <typename T>
+    constexpr T sinDegree(int degree)
+    {
+        return s_trigonometryTable<T>.sine[degree - TrigonometryTable<T>::s_minDegree];
+    }
+
+    template <typename T>
+    constexpr T cosDegree(int degree)
+    {
+        return s_trigonometryTable<T>.cosine[degree - TrigonometryTable<T>::s_minDegree];
+    }
+}
+
+#endif
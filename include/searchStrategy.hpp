@@ -0,0 +1,45 @@
+#ifndef SEARCH_STRATEGY_HPP
+#define SEARCH_STRATEGY_HPP
+
+#include "phenotype.hpp"
+#include "random.hpp"
+#include "solverConfig.hpp"
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Optimizer breeding the populations evaluated by the Solver. The Solver flies
+// and scores every individual, the strategy only decides what to fly next.
+class SearchStrategy
+{
+public:
+    explicit SearchStrategy(const SolverConfig& config);
+    virtual ~SearchStrategy();
+
+    virtual std::vector<Phenotype> initialPopulation(utils::RandomEngine& engine) = 0;
+    // Receives the scored population and fills the next one to evaluate
+    virtual void nextPopulation(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine) = 0;
+
+    // Internal state of the strategy, saved with the checkpoints
+    virtual void saveState(std::ostream& stream) const;
+    virtual void loadState(std::istream& stream);
+
+protected:
+    // Continuous relaxation of a genome : each gene becomes two coordinates in
+    // [-1, 1], scaled to the range of the angle and thrust deltas on decoding
+    std::size_t dimension() const noexcept;
+    std::vector<double> randomPoint(utils::RandomEngine& engine) const;
+    static Phenotype decode(const std::vector<double>& point);
+
+protected:
+    SolverConfig m_config;
+};
+
+std::unique_ptr<SearchStrategy> createStrategy(const SolverConfig& config);
+StrategyType strategyFromName(const std::string& name);
+std::string strategyName(StrategyType type);
+
+#endif
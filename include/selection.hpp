@@ -0,0 +1,75 @@
+#ifndef SELECTION_HPP
+#define SELECTION_HPP
+
+#include "phenotype.hpp"
+#include "random.hpp"
+#include "solverConfig.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Parent selection. The scores are gathered or ranked once per generation in
+// prepare(), after which every select() returns an index in constant time :
+// tournaments compare contiguous scores, rank-based and roulette selections are
+// a single draw from an alias table, and stochastic universal sampling a walk
+// through a precomputed batch. The alias table of the rank-based selection only
+// depends on the population size, and is kept from one generation to the next.
+// Random numbers are taken from the engine directly, without constructing any
+// distribution.
+class Selector
+{
+public:
+    explicit Selector(SelectionMethod method = SelectionMethod::TOURNAMENT);
+    virtual ~Selector();
+
+    void prepare(const std::vector<Phenotype>& population);
+    // Same, on scores other than the ones of the phenotypes (see Niching)
+    void prepare(const std::vector<double>& scores);
+    std::size_t select(utils::RandomEngine& engine);
+
+    SelectionMethod method() const noexcept;
+
+private:
+    void prepareScores();
+    void rankScores();
+    void radixSort();
+    void computeRankProbabilities(std::size_t size);
+    void computeFitnessProbabilities();
+    void buildAliasTable();
+    void sampleUniversally(utils::RandomEngine& engine);
+
+    std::uint64_t nextDraw(utils::RandomEngine& engine);
+    std::size_t drawIndex(utils::RandomEngine& engine, std::size_t size);
+
+private:
+    struct RankedScore
+    {
+        std::uint64_t key;
+        std::uint32_t index;
+    };
+
+    static std::size_t s_tournamentSize;
+    static double s_rankPressure;
+    static std::size_t s_radixSortThreshold;
+
+    SelectionMethod m_method;
+    std::vector<double> m_scores;
+    std::vector<double> m_probabilities;
+    std::vector<RankedScore> m_rankedScores;
+    std::vector<RankedScore> m_sortBuffer;
+    std::vector<std::uint32_t> m_ranking;
+
+    // Alias table, the thresholds being expressed on the range of the draws
+    std::vector<std::uint64_t> m_thresholds;
+    std::vector<std::uint32_t> m_aliases;
+
+    // Batch of the stochastic universal sampling
+    std::vector<std::uint32_t> m_sampled;
+    std::size_t m_nextSampled;
+};
+
+SelectionMethod selectionFromName(const std::string& name);
+std::string selectionName(SelectionMethod method);
+
+#endif
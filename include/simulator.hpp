@@ -1,14 +1,17 @@
 #ifndef SIMULATOR_HPP
 #define SIMULATOR_HPP
 
-#include "phenotype.hpp"
+#include "solver.hpp"
+#include "level.hpp"
 #include "point.hpp"
-#include "lander.hpp"
+#include "landerShape.hpp"
 
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/Time.hpp>
 
-#include <optional>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace sf { class RenderWindow; }
 
@@ -26,36 +29,42 @@ public:
     Simulator();
     virtual ~Simulator();
 
-    void run(const Point2d& position, const Point2d& velocity, int fuel, int angle, int thrust, const Polyline& surfacePoints);
-    void update(sf::Time dt);
+    void run(std::shared_ptr<const PreparedLevel> level);
+    void resume(const std::string& checkpointFileName, const Level& level);
+    // A running search goes on against the edited level, otherwise it is cleared
+    void updateLevel(std::shared_ptr<const PreparedLevel> level);
+    // Returns whether anything it draws has moved
+    bool update(sf::Time dt);
     void render(sf::RenderWindow& window);
     void clear();
+    bool hasLanded() const noexcept;
+    void saveReplay(const std::string& fileName) const;
     const std::size_t numberOfIterations() const noexcept;
     Status status() const noexcept;
 
+    // Performance figures, see PerformanceHud
+    std::size_t numberOfSteps() const noexcept;
+    std::size_t numberOfCollisionTests() const noexcept;
+    sf::Time generationTime() const noexcept;
+    double bestScore() const noexcept;
+
 private:
+    void start(const Point2d& position);
     void geneticIteration();
-    std::vector<Phenotype> generateInitialPopulation(std::size_t geneLength);
-    Phenotype chooseParent();
-    Phenotype arithmeticCrossover(const Phenotype& parent1, const Phenotype& parent2);
-    void mutate(Phenotype& phenotype);
-    std::optional<Point2d> hasCrossedSurface(const Polyline& line) const;
 
 private:
-    static size_t s_populationSize;
-    static size_t s_geneLength;
     static sf::Time s_deltaUpdateTime;
-    static double s_crossoverRate;
-    static double s_mutationRate;
+    static RecordingPolicy s_recordingPolicy;
+    static std::size_t s_recordingSampleSize;
     
-    std::vector<Phenotype> m_population;
+    Solver m_solver;
     std::vector<sf::VertexArray> m_trajectories;
-    Lander m_lander;
+    LanderShape m_landerShape;
     Polyline m_solution;
-    Polyline m_surfacePoints;
-    Polyline m_landingLine;
     sf::Time m_updateTime;
-    std::size_t m_numberOfIterations;
+    // Time spent in the solver by the last generation, and its best score
+    sf::Time m_generationTime;
+    double m_bestScore;
     Status m_status;
 };
 
@@ -0,0 +1,41 @@
+#ifndef SOCKET_HPP
+#define SOCKET_HPP
+
+#include <cstddef>
+#include <string>
+
+// Blocking stream socket, over a Unix domain socket or TCP. Addresses are
+// either "unix:<path>" or "<host>:<port>". Sending to a closed peer reports a
+// failure instead of raising SIGPIPE.
+class Socket
+{
+public:
+    Socket() noexcept;
+    explicit Socket(int descriptor) noexcept;
+    virtual ~Socket();
+
+    Socket(Socket&& other) noexcept;
+    Socket& operator =(Socket&& other) noexcept;
+    Socket(const Socket&) = delete;
+    Socket& operator =(const Socket&) = delete;
+
+    static Socket connect(const std::string& address);
+    static Socket listen(const std::string& address);
+    Socket accept() const;
+
+    // Both return false once the peer is gone
+    bool sendAll(const char* data, std::size_t size);
+    bool receiveAll(char* data, std::size_t size);
+    // A receive waiting longer than this fails, 0 to wait for ever
+    bool setReceiveTimeout(double seconds);
+
+    void close() noexcept;
+    bool isOpen() const noexcept;
+    int descriptor() const noexcept;
+
+private:
+    int m_descriptor;
+    std::string m_unixPath;
+};
+
+#endif
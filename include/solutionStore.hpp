@@ -0,0 +1,73 @@
+#ifndef SOLUTION_STORE_HPP
+#define SOLUTION_STORE_HPP
+
+#include "controlEncoding.hpp"
+#include "level.hpp"
+#include "phenotype.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// What decides the shape of a landing on a level, scaled to similar ranges :
+// the start state, the landing area and the terrain envelope, as the height of
+// the ground every 500m across the zone
+constexpr std::size_t s_numberOfLevelFeatures = 24;
+using LevelFeatures = std::array<float, s_numberOfLevelFeatures>;
+
+LevelFeatures levelFeatures(const Level& level);
+
+struct StoredSolution
+{
+    std::uint64_t levelHash{0};
+    LevelFeatures features{};
+    // Generations a search from scratch took on the level, 0 when it was only
+    // solved with a warm start
+    std::uint32_t coldGenerations{0};
+    // One command per flown step, as in the replays
+    std::vector<Gene> genes;
+};
+
+struct SolutionNeighbour
+{
+    const StoredSolution* solution;
+    float distance;
+};
+
+// Landings found on past levels, kept to warm start the searches on similar
+// ones. The features are held in one flat array which a query scans whole :
+// a few thousand solutions are ranked in microseconds, with no index to keep
+// up to date. There is one solution per level, the last one found, which keeps
+// the cold generations of the one it replaces when it has none.
+class SolutionStore
+{
+public:
+    SolutionStore() = default;
+
+    void add(StoredSolution solution);
+    // The k closest solutions within the distance, closest first
+    std::vector<SolutionNeighbour> nearest(const LevelFeatures& features, std::size_t k,
+                                           float maxDistance = std::numeric_limits<float>::infinity()) const;
+    std::size_t size() const noexcept;
+
+    // Binary format, in the byte order of the host : magic "MLSS", format
+    // version, number of solutions, then for each one the level hash, the
+    // features, the cold generations and the genes
+    void save(const std::string& fileName) const;
+    static SolutionStore load(const std::string& fileName);
+
+private:
+    std::vector<StoredSolution> m_solutions;
+    std::vector<float> m_features;
+    std::unordered_map<std::uint64_t, std::size_t> m_indexByLevel;
+};
+
+// Genome flying the stored commands with the given encoding, exact when it is
+// the encoding the solution was found with
+Phenotype warmStartGenome(const StoredSolution& solution, const ControlEncoding& encoding);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef SOLVE_ASYNC_HPP
+#define SOLVE_ASYNC_HPP
+
+#include "level.hpp"
+#include "levelCache.hpp"
+#include "replay.hpp"
+#include "solverConfig.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+
+// Flag shared by all the copies of a token : the caller keeps one and cancels
+// it, the solve given another one stops before its next generation
+class CancellationToken
+{
+public:
+    CancellationToken();
+
+    void cancel() noexcept;
+    bool isCancelled() const noexcept;
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_isCancelled;
+};
+
+enum class SolveStatus
+{
+    LANDED,
+    OUT_OF_ITERATIONS,
+    OUT_OF_TIME,
+    CANCELLED
+};
+
+// State of a solve after a generation
+struct SolveProgress
+{
+    std::size_t numberOfIterations{0};
+    std::size_t numberOfEvaluations{0};
+    double bestScore{0.0};
+    double seconds{0.0};
+};
+
+struct SolveOptions
+{
+    // 0 for no limit
+    std::size_t maxIterations{0};
+    // Wall-clock time of the search, zero for no limit. A generation is not
+    // started when the last one shows it would end past the budget.
+    std::chrono::steady_clock::duration timeBudget{std::chrono::steady_clock::duration::zero()};
+    CancellationToken cancellation;
+    // Called on the solving thread every progressInterval generations
+    std::function<void(const SolveProgress&)> onProgress;
+    std::size_t progressInterval{1};
+};
+
+struct Solution
+{
+    SolveStatus status{SolveStatus::OUT_OF_ITERATIONS};
+    // One command per flown step, no genes without a landing
+    Replay replay;
+    std::size_t numberOfIterations{0};
+    std::size_t numberOfEvaluations{0};
+    double bestScore{0.0};
+    double seconds{0.0};
+};
+
+// Library entry points of the search, free of any rendering type. Each solve
+// owns its Solver, so that many of them can run at once : solveAsync flies it
+// on a thread of its own, and the errors of the search are thrown by the get
+// of the future. The rollouts of the robust fitness and of the beam search
+// take one thread per core by default, which concurrent solves should lower.
+Solution solve(std::shared_ptr<const PreparedLevel> level, const SolverConfig& config, const SolveOptions& options = SolveOptions());
+std::future<Solution> solveAsync(std::shared_ptr<const PreparedLevel> level, const SolverConfig& config, SolveOptions options = SolveOptions());
+// The level is prepared through the shared level cache, on the solving thread
+std::future<Solution> solveAsync(const Level& level, const SolverConfig& config, SolveOptions options = SolveOptions());
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include "beamSearch.hpp"
+#include "checkpoint.hpp"
+#include "level.hpp"
+#include "levelCache.hpp"
+#include "localSearch.hpp"
+#include "lander.hpp"
+#include "phenotype.hpp"
+#include "point.hpp"
+#include "random.hpp"
+#include "replay.hpp"
+#include "robustEvaluator.hpp"
+#include "searchStrategy.hpp"
+#include "solverConfig.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Which individuals of a generation get their trajectory reconstructed for display
+enum class RecordingPolicy
+{
+    NONE,
+    BEST_ONLY,
+    SAMPLED,
+    ALL
+};
+
+// Search for a landing, free of any rendering concern. The optimizer breeding
+// the generations is the strategy chosen in the configuration, or the beam
+// search planner whose beam then stands for the population.
+// The Simulator drives it for the visualisation, the headless tools directly.
+// The best near misses of each generation can be refined by a local search
+// before breeding, and the genomes can be scored on perturbed starts of the
+// level, when enabled in the configuration. The initial population can be
+// seeded with controller flights and with the landings of similar levels.
+// Rollouts never record their trajectory : the trajectories of the individuals
+// to display are flown again from their genes, on demand.
+class Solver
+{
+public:
+    explicit Solver(const SolverConfig& config = SolverConfig());
+    virtual ~Solver();
+
+    void run(const Level& level);
+    void run(std::shared_ptr<const PreparedLevel> level);
+    void resume(const Checkpoint& checkpoint, const Level& level);
+    // Goes on with the search on an edited version of the level : the population
+    // is kept, and scored on the new surface from the next generation
+    void updateLevel(std::shared_ptr<const PreparedLevel> level);
+    void clear();
+    bool geneticIteration();
+
+    Checkpoint checkpoint() const;
+    Replay replay() const;
+    void enableCheckpoints(const std::string& fileName, std::size_t interval);
+    // Genomes which take the first places of the initial population of the
+    // next runs, such as the landings of similar levels (see SolutionStore)
+    void setWarmStart(std::vector<Phenotype> genomes);
+
+    const SolverConfig& config() const noexcept;
+    const Lander& lander() const noexcept;
+    const Terrain& terrain() const;
+    const std::vector<Phenotype>& population() const noexcept;
+    const std::vector<Phenotype>& evaluatedPopulation() const noexcept;
+    std::vector<std::size_t> recordedIndividuals(RecordingPolicy policy, std::size_t sampleSize) const;
+    Polyline trajectory(std::size_t individual) const;
+    std::size_t numberOfIterations() const noexcept;
+    std::size_t numberOfEvaluations() const noexcept;
+    // Work of the evaluations of the generations, for the performance figures
+    std::size_t numberOfSteps() const noexcept;
+    std::size_t numberOfCollisionTests() const noexcept;
+    bool hasLanded() const noexcept;
+    std::size_t solutionIndex() const noexcept;
+    const Phenotype& solution() const;
+
+private:
+    void setLevel(std::shared_ptr<const PreparedLevel> level);
+    void createRobustEvaluator();
+    void seedPopulation();
+    bool evaluatePopulation();
+    bool evaluatePopulationRobustly();
+    bool refineNearMisses();
+    bool plannerIteration();
+
+private:
+    SolverConfig m_config;
+    utils::RandomEngine m_randomEngine;
+    std::unique_ptr<SearchStrategy> m_strategy;
+    std::unique_ptr<BeamSearch> m_planner;
+    std::unique_ptr<RobustEvaluator> m_robustEvaluator;
+    std::vector<Phenotype> m_population;
+    std::vector<Phenotype> m_lastGeneration;
+    std::vector<Phenotype> m_warmStart;
+    Lander m_lander;
+    std::shared_ptr<const PreparedLevel> m_level;
+    std::size_t m_numberOfIterations;
+    std::size_t m_numberOfEvaluations;
+    std::size_t m_numberOfSteps;
+    std::size_t m_numberOfCollisionTests;
+    std::optional<std::size_t> m_solutionIndex;
+    std::size_t m_solutionSteps;
+    std::unique_ptr<CheckpointWriter> m_checkpointWriter;
+    std::size_t m_checkpointInterval;
+};
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef SOLVER_CONFIG_HPP
+#define SOLVER_CONFIG_HPP
+
+#include "controlEncoding.hpp"
+#include "random.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Optimizers available to breed the populations flown by the Solver
+enum class StrategyType : std::uint32_t
+{
+    GENETIC,
+    DIFFERENTIAL_EVOLUTION,
+    CMA_ES,
+    EVOLUTION_STRATEGY,
+    // Tree search over the states of the lander, run by the Solver itself
+    BEAM_SEARCH
+};
+
+// Parent selection of the genetic strategy
+enum class SelectionMethod : std::uint32_t
+{
+    TOURNAMENT,
+    RANK,
+    STOCHASTIC_UNIVERSAL,
+    ROULETTE
+};
+
+// Diversity pressure of the genetic strategy, on the distance between genomes
+enum class NichingMethod : std::uint32_t
+{
+    NONE,
+    // The score of an individual is divided by the number of genomes around it
+    SHARING,
+    // Each child only replaces the closest of its two parents, if it beats it
+    CROWDING
+};
+
+// How the niche sizes of the fitness sharing are counted
+enum class NichingApproximation : std::uint32_t
+{
+    // Every pair of genomes
+    EXACT,
+    // A random sample of the population for each genome
+    SAMPLING,
+    // The genomes of the same bucket of a locality-sensitive hash
+    LSH
+};
+
+struct NichingConfig
+{
+    NichingMethod method{NichingMethod::NONE};
+    // Radius of a niche, as a mean difference per coordinate : the angle delta
+    // and the thrust delta of a gene are two coordinates, a thrust delta
+    // counting as 15 degrees, so that it is half the difference per gene
+    double radius{2.0};
+    NichingApproximation approximation{NichingApproximation::EXACT};
+    // Genomes compared with each one by the approximations
+    std::size_t samples{64};
+};
+
+// Memetic refinement of the best individuals which reach the landing area
+// without landing safely, after each generation
+struct LocalSearchConfig
+{
+    // Number of individuals refined per generation, 0 to disable it
+    std::size_t individuals{0};
+    // Number of genes before the impact which are searched
+    std::size_t tailGenes{20};
+    // Budget of rollouts per generation, shared by the refined individuals
+    std::size_t evaluations{200};
+};
+
+// Placement of the worker threads on the logical processors (see CpuTopology)
+enum class PinningPolicy : std::uint32_t
+{
+    // Left to the operating system
+    NONE,
+    // Filling a NUMA node before the next one, one thread per core first
+    COMPACT,
+    // Spread round-robin over the NUMA nodes
+    SCATTER
+};
+
+// Robust fitness : every genome is flown from the nominal start and from
+// perturbed ones, and scored on a low quantile of the outcomes
+struct RobustnessConfig
+{
+    // Number of starts, the nominal one included, 0 to disable it
+    std::size_t samples{0};
+    // Uniform perturbations, in m, m/s and litres
+    double positionNoise{50.0};
+    double velocityNoise{5.0};
+    int fuelNoise{50};
+    // Quantile of the scores of the starts, 0 for the worst case. A landing
+    // must also land from the same share of the starts.
+    double quantile{0.0};
+    // Threads flying the rollouts, 0 for one per core
+    std::size_t threads{0};
+    PinningPolicy pinning{PinningPolicy::NONE};
+};
+
+// Beam search planner
+struct BeamSearchConfig
+{
+    // States kept at each depth, doubled whenever the beam dies out
+    std::size_t width{64};
+    // Widest beam tried before the search gives up
+    std::size_t maxWidth{4096};
+    // Steps of an action, which keeps the same angle and thrust deltas
+    std::size_t stepsPerAction{5};
+    // Threads flying the rollouts of the children, 0 for one per core
+    std::size_t threads{0};
+    PinningPolicy pinning{PinningPolicy::NONE};
+};
+
+struct SolverConfig
+{
+    std::size_t populationSize{100};
+    // Number of steps covered by the genes of the initial genomes
+    std::size_t geneLength{160};
+    double crossoverRate{0.95};
+    double mutationRate{0.03};
+    std::uint64_t seed{utils::timeSeed()};
+    StrategyType strategy{StrategyType::GENETIC};
+    SelectionMethod selection{SelectionMethod::TOURNAMENT};
+    NichingConfig niching;
+    ControlEncoding encoding;
+    // Share of the initial population of the genetic strategy flown by the
+    // controllers of ControllerSeeder instead of drawn at random
+    double seedingFraction{0.0};
+    LocalSearchConfig localSearch;
+    RobustnessConfig robustness;
+    BeamSearchConfig beamSearch;
+};
+
+#endif
@@ -0,0 +1,675 @@
+#ifndef TERRAIN_HPP
+#define TERRAIN_HPP
+
+#include "binaryStream.hpp"
+#include "geometry.hpp"
+#include "point.hpp"
+#include "reachability.hpp"
+#include "scalar.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+template <typename T>
+struct Bounds
+{
+    T minX;
+    T maxX;
+    T minY;
+    T maxY;
+};
+
+// Surface of a level with the data derived from it for the collision tests :
+// the landing segment, the bounding box of every segment, and a collision index
+// made of vertical columns of fixed width. Each column knows the range of the
+// segments crossing it and the highest ground below it (the terrain envelope),
+// so that a step of the lander is only tested against the few segments under
+// it, and not at all while it flies above the envelope.
+// It also holds a distance field to the landing area, on a coarse grid over the
+// zone : the length of the shortest way through the air, around the obstacles.
+// A lander which crashed behind a cliff is as far from the landing area as the
+// way over the cliff, and not as the crow flies.
+// Last, a reachability table tells the rollouts when the lander is too fast to
+// ever land, so that they stop there.
+// The surface can be edited in place : only the columns under the edited
+// segments are rebuilt, and the distance field and the reachability table only
+// when the free space or the landing area they depend on changed.
+template <typename T>
+class BasicTerrain
+{
+public:
+    struct Column
+    {
+        std::uint32_t firstSegment;
+        std::uint32_t lastSegment;
+        T highestGround;
+    };
+
+public:
+    BasicTerrain() = default;
+    explicit BasicTerrain(const BasicPolyline<T>& surfacePoints);
+
+    // Returns the point where the segment [p, q] first crosses the surface, if any
+    std::optional<Point2<T>> intersection(const Point2<T>& p, const Point2<T>& q) const;
+    // Same, adding to segmentTests the number of segments exactly tested
+    std::optional<Point2<T>> intersection(const Point2<T>& p, const Point2<T>& q, std::size_t& segmentTests) const;
+
+    // Distance from a point to the middle of the landing area, around the
+    // obstacles. Points below the ground are lifted to the ground first.
+    T distanceToLanding(const Point2<T>& point) const;
+
+    // False once no flight from this state can touch down on the landing area
+    template <typename U>
+    bool canReachLanding(const BasicLander<U>& lander) const noexcept;
+
+    // An edit which would leave the surface without a flat area throws, and
+    // leaves the terrain unchanged. Moving the ends of the surface sideways
+    // changes the extent of the index, which is then built again.
+    void moveVertex(std::size_t index, const Point2<T>& position);
+    // The new vertex comes before the given index
+    void insertVertex(std::size_t index, const Point2<T>& position);
+    void removeVertex(std::size_t index);
+
+    const BasicPolyline<T>& surfacePoints() const noexcept;
+    const BasicPolyline<T>& landingLine() const noexcept;
+    const std::vector<Bounds<T>>& segmentBounds() const noexcept;
+    const std::vector<Column>& columns() const noexcept;
+    T highestGround() const noexcept;
+
+    void save(std::ostream& stream) const;
+    static BasicTerrain load(std::istream& stream);
+
+private:
+    std::size_t columnIndex(const T& x) const noexcept;
+    std::optional<double> groundHeight(double x) const;
+    void edit(BasicPolyline<T> surfacePoints, std::size_t firstSegment, std::size_t lastSegment,
+              std::size_t shiftedSegment, int shift, const T& editedLeft, const T& editedRight);
+    void buildColumns(std::size_t firstColumn, std::size_t lastColumn);
+    void buildDistanceField(const T& right);
+    bool updateFreeRows(std::uint32_t firstColumn, std::uint32_t lastColumn);
+    void propagateDistances();
+    Point2d cellCenter(std::size_t column, std::size_t row) const noexcept;
+
+private:
+    static constexpr double s_columnWidth = 250.0;
+    static constexpr double s_fieldCellSize = 25.0;
+    static constexpr double s_zoneHeight = 3000.0;
+
+    BasicPolyline<T> m_surfacePoints;
+    BasicPolyline<T> m_landingLine;
+    std::vector<Bounds<T>> m_segmentBounds;
+    std::vector<Column> m_columns;
+    T m_left{0};
+    T m_highestGround{0};
+
+    // Row after row, infinite where the landing area cannot be reached
+    std::vector<float> m_distanceField;
+    std::vector<std::uint32_t> m_lowestFreeRow;
+    std::uint32_t m_fieldColumns{0};
+    std::uint32_t m_fieldRows{0};
+
+    ReachabilityTable m_reachability;
+};
+
+using Terrain = BasicTerrain<double>;
+
+template <typename T>
+BasicTerrain<T>::BasicTerrain(const BasicPolyline<T>& surfacePoints)
+    : m_surfacePoints(surfacePoints)
+{
+    if (m_surfacePoints.size() < 2)
+    {
+        throw std::runtime_error("BasicTerrain::BasicTerrain - The surface needs at least two points");
+    }
+
+    auto hasSameYCoordinate = [] (const Point2<T>& p, const Point2<T>& q) { return p.y == q.y; };
+    auto flat = std::adjacent_find(m_surfacePoints.begin(), m_surfacePoints.end(), hasSameYCoordinate);
+    if (flat == m_surfacePoints.end())
+    {
+        throw std::runtime_error("BasicTerrain::BasicTerrain - The surface has no flat area to land on");
+    }
+    m_landingLine = {*flat, *std::next(flat)};
+
+    T right = m_surfacePoints.front().x;
+    m_left = m_surfacePoints.front().x;
+    m_highestGround = m_surfacePoints.front().y;
+    for (std::size_t i = 0; i + 1 < m_surfacePoints.size(); ++i)
+    {
+        const Point2<T>& a = m_surfacePoints[i];
+        const Point2<T>& b = m_surfacePoints[i + 1];
+        m_segmentBounds.push_back({std::min(a.x, b.x), std::max(a.x, b.x), std::min(a.y, b.y), std::max(a.y, b.y)});
+
+        m_left = std::min(m_left, m_segmentBounds.back().minX);
+        right = std::max(right, m_segmentBounds.back().maxX);
+        m_highestGround = std::max(m_highestGround, m_segmentBounds.back().maxY);
+    }
+
+    // A segment belongs to every column its bounding box overlaps. On a surface
+    // which is not monotonic in x, the range of a column may also hold
+    // segments that do not cross it, which only costs a few extra tests.
+    m_columns.resize(columnIndex(right) + 1, Column{std::uint32_t(-1), 0, m_surfacePoints.front().y});
+    std::vector<bool> isEmpty(m_columns.size(), true);
+    for (std::size_t segment = 0; segment < m_segmentBounds.size(); ++segment)
+    {
+        const Bounds<T>& bounds = m_segmentBounds[segment];
+        for (std::size_t c = columnIndex(bounds.minX); c <= columnIndex(bounds.maxX); ++c)
+        {
+            Column& column = m_columns[c];
+            column.firstSegment = std::min(column.firstSegment, static_cast<std::uint32_t>(segment));
+            column.lastSegment = std::max(column.lastSegment, static_cast<std::uint32_t>(segment));
+            column.highestGround = isEmpty[c] ? bounds.maxY : std::max(column.highestGround, bounds.maxY);
+            isEmpty[c] = false;
+        }
+    }
+
+    buildDistanceField(right);
+
+    T lowestGround = m_surfacePoints.front().y;
+    for (const Point2<T>& point : m_surfacePoints)
+    {
+        lowestGround = std::min(lowestGround, point.y);
+    }
+    m_reachability.build(scalar::toDouble(m_landingLine[0].y), scalar::toDouble(lowestGround), s_zoneHeight);
+}
+
+template <typename T>
+void BasicTerrain<T>::buildDistanceField(const T& right)
+{
+    const double width = scalar::toDouble(right - m_left);
+    const double height = std::max(s_zoneHeight, scalar::toDouble(m_highestGround) + 4.0 * s_fieldCellSize);
+    m_fieldColumns = static_cast<std::uint32_t>(std::max(1.0, std::ceil(width / s_fieldCellSize)));
+    m_fieldRows = static_cast<std::uint32_t>(std::ceil(height / s_fieldCellSize));
+
+    m_lowestFreeRow.assign(m_fieldColumns, m_fieldRows);
+    updateFreeRows(0, m_fieldColumns - 1);
+    propagateDistances();
+}
+
+template <typename T>
+bool BasicTerrain<T>::updateFreeRows(std::uint32_t firstColumn, std::uint32_t lastColumn)
+{
+    // Cells whose center is above the ground are free
+    bool hasChanged = false;
+    for (std::uint32_t c = firstColumn; c <= lastColumn && c < m_fieldColumns; ++c)
+    {
+        const double ground = groundHeight(cellCenter(c, 0).x).value_or(0.0);
+        const double row = std::floor(ground / s_fieldCellSize + 0.5);
+        const std::uint32_t lowestFreeRow = static_cast<std::uint32_t>(std::clamp(row, 0.0, static_cast<double>(m_fieldRows)));
+
+        hasChanged = hasChanged || lowestFreeRow != m_lowestFreeRow[c];
+        m_lowestFreeRow[c] = lowestFreeRow;
+    }
+
+    return hasChanged;
+}
+
+template <typename T>
+void BasicTerrain<T>::propagateDistances()
+{
+    auto isFree = [this] (long c, long r)
+    {
+        return c >= 0 && r >= 0 && c < static_cast<long>(m_fieldColumns) && r < static_cast<long>(m_fieldRows) &&
+               static_cast<std::uint32_t>(r) >= m_lowestFreeRow[c];
+    };
+
+    // Dijkstra from the cells right above the landing area, each starting at its
+    // distance to the middle of it
+    using Entry = std::pair<double, std::uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    std::vector<double> distances(std::size_t(m_fieldColumns) * m_fieldRows, std::numeric_limits<double>::infinity());
+
+    const Point2d target{scalar::toDouble(m_landingLine[0].x + m_landingLine[1].x) / 2.0, scalar::toDouble(m_landingLine[0].y)};
+    const double landingLeft = scalar::toDouble(std::min(m_landingLine[0].x, m_landingLine[1].x));
+    const double landingRight = scalar::toDouble(std::max(m_landingLine[0].x, m_landingLine[1].x));
+    for (std::uint32_t c = 0; c < m_fieldColumns; ++c)
+    {
+        const Point2d center = cellCenter(c, m_lowestFreeRow[c]);
+        if (center.x >= landingLeft && center.x <= landingRight && isFree(c, m_lowestFreeRow[c]))
+        {
+            const std::uint32_t cell = m_lowestFreeRow[c] * m_fieldColumns + c;
+            distances[cell] = utils::length(center, target);
+            queue.push({distances[cell], cell});
+        }
+    }
+
+    // Straight, diagonal and knight moves, which keep the error on the length of
+    // a straight way through the grid below 3%. A move only goes between free
+    // cells, through free cells.
+    const long moves[16][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1},
+                               {2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}};
+    while (!queue.empty())
+    {
+        const auto [distance, cell] = queue.top();
+        queue.pop();
+        if (distance > distances[cell])
+            continue;
+
+        const long c = cell % m_fieldColumns;
+        const long r = cell / m_fieldColumns;
+        for (const auto& move : moves)
+        {
+            const long dc = move[0];
+            const long dr = move[1];
+            if (!isFree(c + dc, r + dr) || !isFree(c + dc / 2 + (dc % 2), r + dr / 2) || !isFree(c + dc / 2, r + dr / 2 + (dr % 2)))
+                continue;
+
+            const std::uint32_t next = static_cast<std::uint32_t>((r + dr) * m_fieldColumns + c + dc);
+            const double nextDistance = distance + s_fieldCellSize * std::sqrt(static_cast<double>(dc * dc + dr * dr));
+            if (nextDistance < distances[next])
+            {
+                distances[next] = nextDistance;
+                queue.push({nextDistance, next});
+            }
+        }
+    }
+
+    m_distanceField.assign(distances.begin(), distances.end());
+}
+
+template <typename T>
+std::optional<double> BasicTerrain<T>::groundHeight(double x) const
+{
+    // Highest point of the surface at this abscissa
+    std::optional<double> height;
+
+    const Column& column = m_columns[columnIndex(static_cast<T>(x))];
+    for (std::uint32_t i = column.firstSegment; i <= column.lastSegment && i < m_segmentBounds.size(); ++i)
+    {
+        const Point2d a = pointCast<double>(m_surfacePoints[i]);
+        const Point2d b = pointCast<double>(m_surfacePoints[i + 1]);
+        if (x < std::min(a.x, b.x) || x > std::max(a.x, b.x))
+            continue;
+
+        const double y = a.x == b.x ? std::max(a.y, b.y) : a.y + (b.y - a.y) * (x - a.x) / (b.x - a.x);
+        height = std::max(height.value_or(y), y);
+    }
+
+    return height;
+}
+
+template <typename T>
+Point2d BasicTerrain<T>::cellCenter(std::size_t column, std::size_t row) const noexcept
+{
+    return {scalar::toDouble(m_left) + (column + 0.5) * s_fieldCellSize, (row + 0.5) * s_fieldCellSize};
+}
+
+template <typename T>
+T BasicTerrain<T>::distanceToLanding(const Point2<T>& point) const
+{
+    const Point2d position = pointCast<double>(point);
+
+    // Shortest way through one of the four closest cell centers, which keeps
+    // the distance continuous between the cells
+    const long column = static_cast<long>(std::floor((position.x - scalar::toDouble(m_left)) / s_fieldCellSize - 0.5));
+    const long row = static_cast<long>(std::floor(position.y / s_fieldCellSize - 0.5));
+
+    double distance = std::numeric_limits<double>::infinity();
+    for (long c = column; c <= column + 1; ++c)
+    {
+        const std::uint32_t clampedColumn = static_cast<std::uint32_t>(std::clamp(c, 0l, static_cast<long>(m_fieldColumns) - 1));
+        for (long r = row; r <= row + 1; ++r)
+        {
+            const long lifted = std::max(r, static_cast<long>(m_lowestFreeRow[clampedColumn]));
+            if (lifted >= static_cast<long>(m_fieldRows))
+                continue;
+
+            const std::uint32_t clampedRow = static_cast<std::uint32_t>(std::max(lifted, 0l));
+            const double cellDistance = m_distanceField[clampedRow * m_fieldColumns + clampedColumn];
+            distance = std::min(distance, cellDistance + utils::length(position, cellCenter(clampedColumn, clampedRow)));
+        }
+    }
+
+    // The grid only matters when the way is blocked : the straight distance is
+    // kept in sight of the landing area, where it is exact, and in enclosed places
+    const Point2d target{scalar::toDouble(m_landingLine[0].x + m_landingLine[1].x) / 2.0, scalar::toDouble(m_landingLine[0].y)};
+    const double straightDistance = utils::length(position, target);
+    if (!std::isfinite(distance) || distance < straightDistance + 2.0 * s_fieldCellSize)
+    {
+        distance = straightDistance;
+    }
+
+    return static_cast<T>(distance);
+}
+
+template <typename T>
+template <typename U>
+bool BasicTerrain<T>::canReachLanding(const BasicLander<U>& lander) const noexcept
+{
+    return m_reachability.canReachLanding(lander);
+}
+
+template <typename T>
+void BasicTerrain<T>::moveVertex(std::size_t index, const Point2<T>& position)
+{
+    if (index >= m_surfacePoints.size())
+    {
+        throw std::runtime_error("BasicTerrain::moveVertex - No such vertex");
+    }
+
+    // The segments on both sides of the vertex
+    const std::size_t firstSegment = index > 0 ? index - 1 : 0;
+    const std::size_t lastSegment = std::min(index, m_segmentBounds.size() - 1);
+    const T left = std::min(m_segmentBounds[firstSegment].minX, m_segmentBounds[lastSegment].minX);
+    const T right = std::max(m_segmentBounds[firstSegment].maxX, m_segmentBounds[lastSegment].maxX);
+
+    BasicPolyline<T> surfacePoints = m_surfacePoints;
+    surfacePoints[index] = position;
+    edit(std::move(surfacePoints), firstSegment, lastSegment, 0, 0, left, right);
+}
+
+template <typename T>
+void BasicTerrain<T>::insertVertex(std::size_t index, const Point2<T>& position)
+{
+    if (index > m_surfacePoints.size())
+    {
+        throw std::runtime_error("BasicTerrain::insertVertex - No such vertex");
+    }
+
+    // The segment which held the new vertex is split in two, at the ends a segment is added
+    const std::size_t splitSegment = std::min(index > 0 ? index - 1 : 0, m_segmentBounds.size() - 1);
+    const T left = m_segmentBounds[splitSegment].minX;
+    const T right = m_segmentBounds[splitSegment].maxX;
+
+    BasicPolyline<T> surfacePoints = m_surfacePoints;
+    surfacePoints.insert(surfacePoints.begin() + index, position);
+    edit(std::move(surfacePoints), index > 0 ? index - 1 : 0, std::min(index, m_surfacePoints.size() - 1), index, 1, left, right);
+}
+
+template <typename T>
+void BasicTerrain<T>::removeVertex(std::size_t index)
+{
+    if (index >= m_surfacePoints.size())
+    {
+        throw std::runtime_error("BasicTerrain::removeVertex - No such vertex");
+    }
+
+    if (m_surfacePoints.size() <= 2)
+    {
+        throw std::runtime_error("BasicTerrain::removeVertex - The surface needs at least two points");
+    }
+
+    // The two segments around the vertex merge, at the ends one segment goes
+    const std::size_t firstSegment = index > 0 ? index - 1 : 0;
+    const std::size_t lastSegment = std::min(index, m_segmentBounds.size() - 1);
+    const T left = std::min(m_segmentBounds[firstSegment].minX, m_segmentBounds[lastSegment].minX);
+    const T right = std::max(m_segmentBounds[firstSegment].maxX, m_segmentBounds[lastSegment].maxX);
+
+    BasicPolyline<T> surfacePoints = m_surfacePoints;
+    surfacePoints.erase(surfacePoints.begin() + index);
+    const std::size_t mergedSegment = std::min(firstSegment, surfacePoints.size() - 2);
+    edit(std::move(surfacePoints), mergedSegment, mergedSegment, index, -1, left, right);
+}
+
+template <typename T>
+void BasicTerrain<T>::edit(BasicPolyline<T> surfacePoints, std::size_t firstSegment, std::size_t lastSegment,
+                           std::size_t shiftedSegment, int shift, const T& editedLeft, const T& editedRight)
+{
+    auto hasSameYCoordinate = [] (const Point2<T>& p, const Point2<T>& q) { return p.y == q.y; };
+    auto flat = std::adjacent_find(surfacePoints.begin(), surfacePoints.end(), hasSameYCoordinate);
+    if (surfacePoints.size() < 2 || flat == surfacePoints.end())
+    {
+        throw std::runtime_error("BasicTerrain::edit - The surface would have no flat area to land on");
+    }
+    const BasicPolyline<T> landingLine{*flat, *std::next(flat)};
+
+    // The columns and the distance field span the surface : when its ends move
+    // sideways, everything is built again
+    auto extent = [] (const BasicPolyline<T>& points)
+    {
+        Bounds<T> bounds{points.front().x, points.front().x, points.front().y, points.front().y};
+        for (const Point2<T>& point : points)
+        {
+            bounds = {std::min(bounds.minX, point.x), std::max(bounds.maxX, point.x), std::min(bounds.minY, point.y), bounds.maxY};
+        }
+        return bounds;
+    };
+
+    const Bounds<T> previousExtent = extent(m_surfacePoints);
+    const Bounds<T> newExtent = extent(surfacePoints);
+    if (newExtent.minX != previousExtent.minX || newExtent.maxX != previousExtent.maxX)
+    {
+        *this = BasicTerrain(surfacePoints);
+        return;
+    }
+
+    // Segments after an inserted or a removed vertex move by one index
+    if (shift > 0)
+    {
+        m_segmentBounds.insert(m_segmentBounds.begin() + std::min(shiftedSegment, m_segmentBounds.size()), Bounds<T>{});
+    }
+    else if (shift < 0)
+    {
+        m_segmentBounds.erase(m_segmentBounds.begin() + std::min(shiftedSegment, m_segmentBounds.size() - 1));
+    }
+
+    m_surfacePoints = std::move(surfacePoints);
+    for (std::size_t i = firstSegment; i <= lastSegment; ++i)
+    {
+        const Point2<T>& a = m_surfacePoints[i];
+        const Point2<T>& b = m_surfacePoints[i + 1];
+        m_segmentBounds[i] = {std::min(a.x, b.x), std::max(a.x, b.x), std::min(a.y, b.y), std::max(a.y, b.y)};
+    }
+
+    if (shift != 0)
+    {
+        for (Column& column : m_columns)
+        {
+            if (column.firstSegment != std::uint32_t(-1) && column.firstSegment >= shiftedSegment)
+                column.firstSegment += shift;
+            if (column.lastSegment >= shiftedSegment)
+                column.lastSegment += shift;
+        }
+    }
+
+    // Only the columns the edited segments covered or now cover
+    T editedMinX = editedLeft;
+    T editedMaxX = editedRight;
+    for (std::size_t i = firstSegment; i <= lastSegment; ++i)
+    {
+        editedMinX = std::min(editedMinX, m_segmentBounds[i].minX);
+        editedMaxX = std::max(editedMaxX, m_segmentBounds[i].maxX);
+    }
+    buildColumns(columnIndex(editedMinX), columnIndex(editedMaxX));
+
+    m_highestGround = m_surfacePoints.front().y;
+    for (const Bounds<T>& bounds : m_segmentBounds)
+    {
+        m_highestGround = std::max(m_highestGround, bounds.maxY);
+    }
+
+    const bool hasLandingChanged = landingLine != m_landingLine;
+    const bool hasLandingHeightChanged = landingLine[0].y != m_landingLine[0].y;
+    m_landingLine = landingLine;
+
+    // The ground only moved under the edited segments, but a new way around an
+    // obstacle changes the distances anywhere : the search runs again then
+    const std::uint32_t fieldRows = static_cast<std::uint32_t>(std::ceil(std::max(s_zoneHeight, scalar::toDouble(m_highestGround) + 4.0 * s_fieldCellSize) / s_fieldCellSize));
+    if (fieldRows != m_fieldRows)
+    {
+        buildDistanceField(newExtent.maxX);
+    }
+    else
+    {
+        const double firstCenter = (scalar::toDouble(editedMinX - m_left)) / s_fieldCellSize - 0.5;
+        const double lastCenter = (scalar::toDouble(editedMaxX - m_left)) / s_fieldCellSize - 0.5;
+        const std::uint32_t firstColumn = static_cast<std::uint32_t>(std::max(0.0, std::floor(firstCenter)));
+        const std::uint32_t lastColumn = static_cast<std::uint32_t>(std::max(0.0, std::ceil(lastCenter)));
+
+        if (updateFreeRows(firstColumn, lastColumn) || hasLandingChanged)
+        {
+            propagateDistances();
+        }
+    }
+
+    if (newExtent.minY != previousExtent.minY || hasLandingHeightChanged)
+    {
+        m_reachability.build(scalar::toDouble(m_landingLine[0].y), scalar::toDouble(newExtent.minY), s_zoneHeight);
+    }
+}
+
+template <typename T>
+void BasicTerrain<T>::buildColumns(std::size_t firstColumn, std::size_t lastColumn)
+{
+    // Same as the construction, restricted to a range of columns
+    for (std::size_t c = firstColumn; c <= lastColumn && c < m_columns.size(); ++c)
+    {
+        Column& column = m_columns[c];
+        column = Column{std::uint32_t(-1), 0, m_surfacePoints.front().y};
+        bool isEmpty = true;
+
+        for (std::size_t segment = 0; segment < m_segmentBounds.size(); ++segment)
+        {
+            const Bounds<T>& bounds = m_segmentBounds[segment];
+            if (c < columnIndex(bounds.minX) || c > columnIndex(bounds.maxX))
+                continue;
+
+            column.firstSegment = std::min(column.firstSegment, static_cast<std::uint32_t>(segment));
+            column.lastSegment = std::max(column.lastSegment, static_cast<std::uint32_t>(segment));
+            column.highestGround = isEmpty ? bounds.maxY : std::max(column.highestGround, bounds.maxY);
+            isEmpty = false;
+        }
+    }
+}
+
+template <typename T>
+std::optional<Point2<T>> BasicTerrain<T>::intersection(const Point2<T>& p, const Point2<T>& q) const
+{
+    std::size_t segmentTests = 0;
+    return intersection(p, q, segmentTests);
+}
+
+template <typename T>
+std::optional<Point2<T>> BasicTerrain<T>::intersection(const Point2<T>& p, const Point2<T>& q, std::size_t& segmentTests) const
+{
+    const T lowestY = std::min(p.y, q.y);
+    if (lowestY > m_highestGround)
+        return std::nullopt;
+
+    const std::size_t firstColumn = columnIndex(std::min(p.x, q.x));
+    const std::size_t lastColumn = columnIndex(std::max(p.x, q.x));
+
+    std::uint32_t firstSegment = std::uint32_t(-1);
+    std::uint32_t lastSegment = 0;
+    bool isAboveEnvelope = true;
+    for (std::size_t c = firstColumn; c <= lastColumn; ++c)
+    {
+        const Column& column = m_columns[c];
+        firstSegment = std::min(firstSegment, column.firstSegment);
+        lastSegment = std::max(lastSegment, column.lastSegment);
+        isAboveEnvelope = isAboveEnvelope && lowestY > column.highestGround;
+    }
+
+    if (isAboveEnvelope)
+        return std::nullopt;
+
+    // Same order as a scan of the whole polyline, so that the first crossed
+    // segment is the same
+    const Bounds<T> step{std::min(p.x, q.x), std::max(p.x, q.x), lowestY, std::max(p.y, q.y)};
+    for (std::uint32_t i = firstSegment; i <= lastSegment && i < m_segmentBounds.size(); ++i)
+    {
+        const Bounds<T>& bounds = m_segmentBounds[i];
+        if (bounds.maxX < step.minX || bounds.minX > step.maxX || bounds.maxY < step.minY || bounds.minY > step.maxY)
+            continue;
+
+        segmentTests++;
+        if (utils::doIntersect(m_surfacePoints[i], m_surfacePoints[i + 1], p, q))
+        {
+            return utils::lineLineIntersection(p, q, m_surfacePoints[i], m_surfacePoints[i + 1]);
+        }
+    }
+
+    return std::nullopt;
+}
+
+template <typename T>
+std::size_t BasicTerrain<T>::columnIndex(const T& x) const noexcept
+{
+    const double offset = scalar::toDouble(x - m_left) / s_columnWidth;
+    if (offset <= 0.0)
+        return 0;
+
+    return std::min(static_cast<std::size_t>(offset), m_columns.empty() ? std::size_t(-1) : m_columns.size() - 1);
+}
+
+template <typename T>
+const BasicPolyline<T>& BasicTerrain<T>::surfacePoints() const noexcept
+{
+    return m_surfacePoints;
+}
+
+template <typename T>
+const BasicPolyline<T>& BasicTerrain<T>::landingLine() const noexcept
+{
+    return m_landingLine;
+}
+
+template <typename T>
+const std::vector<Bounds<T>>& BasicTerrain<T>::segmentBounds() const noexcept
+{
+    return m_segmentBounds;
+}
+
+template <typename T>
+const std::vector<typename BasicTerrain<T>::Column>& BasicTerrain<T>::columns() const noexcept
+{
+    return m_columns;
+}
+
+template <typename T>
+T BasicTerrain<T>::highestGround() const noexcept
+{
+    return m_highestGround;
+}
+
+template <typename T>
+void BasicTerrain<T>::save(std::ostream& stream) const
+{
+    utils::writeBinaryVector(stream, m_surfacePoints);
+    utils::writeBinaryVector(stream, m_landingLine);
+    utils::writeBinaryVector(stream, m_segmentBounds);
+    utils::writeBinaryVector(stream, m_columns);
+    utils::writeBinary(stream, m_left);
+    utils::writeBinary(stream, m_highestGround);
+    utils::writeBinaryVector(stream, m_distanceField);
+    utils::writeBinaryVector(stream, m_lowestFreeRow);
+    utils::writeBinary(stream, m_fieldColumns);
+    utils::writeBinary(stream, m_fieldRows);
+    m_reachability.save(stream);
+}
+
+template <typename T>
+BasicTerrain<T> BasicTerrain<T>::load(std::istream& stream)
+{
+    BasicTerrain terrain;
+    terrain.m_surfacePoints = utils::readBinaryVector<Point2<T>>(stream);
+    terrain.m_landingLine = utils::readBinaryVector<Point2<T>>(stream);
+    terrain.m_segmentBounds = utils::readBinaryVector<Bounds<T>>(stream);
+    terrain.m_columns = utils::readBinaryVector<Column>(stream);
+    terrain.m_left = utils::readBinary<T>(stream);
+    terrain.m_highestGround = utils::readBinary<T>(stream);
+    terrain.m_distanceField = utils::readBinaryVector<float>(stream);
+    terrain.m_lowestFreeRow = utils::readBinaryVector<std::uint32_t>(stream);
+    terrain.m_fieldColumns = utils::readBinary<std::uint32_t>(stream);
+    terrain.m_fieldRows = utils::readBinary<std::uint32_t>(stream);
+    terrain.m_reachability = ReachabilityTable::load(stream);
+
+    if (!stream || terrain.m_landingLine.size() != 2 || terrain.m_columns.empty() ||
+        terrain.m_segmentBounds.size() + 1 != terrain.m_surfacePoints.size() ||
+        terrain.m_lowestFreeRow.size() != terrain.m_fieldColumns ||
+        terrain.m_distanceField.size() != std::size_t(terrain.m_fieldColumns) * terrain.m_fieldRows)
+    {
+        throw std::runtime_error("BasicTerrain::load - Invalid terrain data");
+    }
+
+    return terrain;
+}
+
+#endif
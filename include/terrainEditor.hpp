@@ -0,0 +1,52 @@
+#ifndef TERRAIN_EDITOR_HPP
+#define TERRAIN_EDITOR_HPP
+
+#include "levelCache.hpp"
+#include "point.hpp"
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace sf { class Event; class RenderTarget; class RenderStates; }
+
+// Edits the surface of the shown level with the mouse, while the editing mode
+// is on : a vertex is dragged with the left button, a right click on a vertex
+// removes it and a right click elsewhere inserts one into the segment below or
+// above the cursor. Each edit makes a new version of the level, whose terrain
+// is updated in place from the former one (see BasicTerrain::moveVertex), and
+// hands it to the callback. Edits which would leave no flat area are refused.
+class TerrainEditor : public sf::Drawable, private sf::NonCopyable
+{
+public:
+    TerrainEditor();
+    virtual ~TerrainEditor();
+
+    void setLevel(std::shared_ptr<const PreparedLevel> level);
+    void setEditedCallback(const std::function<void(std::shared_ptr<const PreparedLevel>)>& editedCallback);
+    void toggle() noexcept;
+    bool isEnabled() const noexcept;
+
+    // Returns whether the event was used by the editor
+    bool handleEvent(const sf::Event& event);
+
+private:
+    virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    std::optional<std::size_t> vertexAt(const Point2d& screenPoint) const;
+    void edit(const std::function<void(Terrain&)>& change);
+    void buildHandles();
+
+private:
+    std::shared_ptr<const PreparedLevel> m_level;
+    std::function<void(std::shared_ptr<const PreparedLevel>)> m_editedCallback;
+    std::optional<std::size_t> m_draggedVertex;
+    sf::VertexArray m_handles;
+    bool m_isEnabled;
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef TOPOLOGY_HPP
+#define TOPOLOGY_HPP
+
+#include "solverConfig.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct LogicalCpu
+{
+    int id;
+    int package;
+    int core;
+    int node;
+    // Rank among the hardware threads of its core
+    int thread;
+};
+
+// Layout of the logical processors, read from the sysfs of Linux : the online
+// processors the process is allowed to run on, the package and core of each
+// one, and the processors of each NUMA node. Where it cannot be read, all the processors of the machine are taken as
+// one node of single-threaded cores.
+class CpuTopology
+{
+public:
+    static CpuTopology read(const std::string& systemDirectory = "/sys/devices/system");
+    static CpuTopology uniform(std::size_t numberOfCpus);
+
+    const std::vector<LogicalCpu>& cpus() const noexcept;
+    std::size_t numberOfNodes() const noexcept;
+    std::size_t numberOfPackages() const noexcept;
+
+    // Logical processor of each worker, empty when they are not pinned. The
+    // workers wrap around when there are more of them than processors.
+    std::vector<int> placement(std::size_t numberOfWorkers, PinningPolicy policy) const;
+
+private:
+    // Processors of each node, the first thread of every core first
+    std::vector<std::vector<int>> nodeOrders() const;
+
+private:
+    std::vector<LogicalCpu> m_cpus;
+};
+
+// Binds the calling thread to a logical processor. Returns false where it is
+// not supported or not allowed, or when the processor is out of range.
+bool pinCurrentThread(int cpu);
+
+// Parses the list format of sysfs, such as "0-3,8-11"
+std::vector<int> parseCpuList(const std::string& list);
+
+PinningPolicy pinningFromName(const std::string& name);
+std::string pinningName(PinningPolicy policy);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include "solverConfig.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Threads kept for the whole life of their owner, placed on the processors by
+// a pinning policy (see CpuTopology). A job is run by every worker at once,
+// given the index of the worker, and the call returns once all of them are
+// done. The calling thread takes its share as the first worker, unless the
+// workers are pinned : it belongs to the caller, whose affinity is left alone,
+// so every pinned worker is a thread of the pool. A worker which cannot be
+// pinned runs unpinned, which is reported once on the error output.
+class WorkerPool
+{
+public:
+    // 0 threads for one per core
+    WorkerPool(std::size_t numberOfThreads, PinningPolicy pinning);
+    virtual ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator =(const WorkerPool&) = delete;
+
+    // Rethrows the first exception thrown by a worker, once all are done
+    void run(const std::function<void(std::size_t)>& job);
+
+    std::size_t size() const noexcept;
+    // Processor of each worker, empty when not pinned
+    const std::vector<int>& placement() const noexcept;
+
+private:
+    void workLoop(std::size_t worker);
+    void runShare(std::size_t worker);
+
+private:
+    std::size_t m_size;
+    std::vector<int> m_placement;
+    const std::function<void(std::size_t)>* m_job;
+    std::exception_ptr m_error;
+
+    std::mutex m_mutex;
+    std::condition_variable m_startCondition;
+    std::condition_variable m_doneCondition;
+    std::size_t m_generation;
+    std::size_t m_numberOfBusyThreads;
+    bool m_isStopping;
+    bool m_isCallerWorker;
+    std::vector<std::thread> m_threads;
+};
+
+#endif
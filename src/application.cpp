@@ -1,28 +1,49 @@
 #include "application.hpp"
 
+#include <SFML/System/Sleep.hpp>
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/VideoMode.hpp>
 
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
 const sf::Time Application::s_timePerFrame = sf::seconds(1.0f / 60.0f);
 
 Application::Application()
     : m_window(sf::VideoMode(1000, 428), "Mars Lander", sf::Style::Close)
+    , m_isStaticLayerDirty(true)
+    , m_needsRedraw(true)
+    , m_cpuStart(std::clock())
+    , m_wallStart(std::chrono::steady_clock::now())
     , m_container(m_window)
+    , m_displayedIterations(0)
 {
     m_window.setKeyRepeatEnabled(false);
 
+    if (!m_staticLayer.create(m_window.getSize().x, m_window.getSize().y))
+    {
+        throw std::runtime_error("Application::Application - Failed to create the static layer");
+    }
+    m_staticSprite.setTexture(m_staticLayer.getTexture());
+
     m_levelLoader.load("resources/data/level_01.txt");
     m_fonts.load(Fonts::Upheaval, "resources/fonts/upheavtt.ttf");
     createButtons();
+    createTerrainEditor();
 
     m_statisticsText.setFont(m_fonts.get(Fonts::Upheaval));
     m_statisticsText.setPosition(700.0f, 5.0f);
     m_statisticsText.setCharacterSize(20u);
+    m_statisticsText.setString("Number of iterations : 0");
+
+    m_performanceHud.setFont(m_fonts.get(Fonts::Upheaval));
+    m_performanceHud.setPosition(740.0f, 35.0f);
 }
 
 Application::~Application()
 {
-
+    reportCpuUsage();
 }
 
 void Application::run()
@@ -32,18 +53,44 @@ void Application::run()
 
     while (m_window.isOpen())
     {
-        sf::Time dt = clock.restart();
-        timeSinceLastUpdate += dt;
-
-        while (timeSinceLastUpdate > s_timePerFrame)
+        // Nothing moves while the simulator is idle : block until an event
+        if (m_simulator.status() == Simulator::Status::IDLE && !m_needsRedraw)
         {
-            timeSinceLastUpdate -= s_timePerFrame;
+            sf::Event event;
+            if (m_window.waitEvent(event))
+            {
+                handleEvent(event);
+                processInput();
+                update(sf::Time::Zero);
+            }
+
+            clock.restart();
+            timeSinceLastUpdate = sf::Time::Zero;
+        }
+        else
+        {
+            sf::Time dt = clock.restart();
+            timeSinceLastUpdate += dt;
 
-            processInput();
-            update(s_timePerFrame);
+            while (timeSinceLastUpdate > s_timePerFrame)
+            {
+                timeSinceLastUpdate -= s_timePerFrame;
+
+                processInput();
+                update(s_timePerFrame);
+            }
         }
 
-        render();
+        if (m_needsRedraw && m_window.isOpen())
+        {
+            render();
+        }
+
+        // The rest of the frame is left to the other threads and processes
+        if (m_simulator.status() != Simulator::Status::IDLE)
+        {
+            sf::sleep(s_timePerFrame - timeSinceLastUpdate - clock.getElapsedTime());
+        }
     }
 }
 
@@ -52,8 +99,7 @@ void Application::createButtons()
     std::shared_ptr<Button> button = std::make_shared<Button>(m_fonts, "Play");
     auto callback = [this] ()
     {
-        const LevelData data = m_levelLoader.levelData();
-        m_simulator.run(data.position, data.velocity, data.fuel, data.angle, data.thrust, m_levelLoader.surfacePoints());
+        m_simulator.run(m_levelLoader.preparedLevel());
     };
     button->setSize(sf::Vector2f(70, 30));
     button->setPressedCallback(callback);
@@ -67,6 +113,7 @@ void Application::createButtons()
         auto callback = [this, id] ()
         {
             m_levelLoader.load("resources/data/level_0" + std::to_string(id) + ".txt");
+            m_terrainEditor.setLevel(m_levelLoader.preparedLevel());
             m_simulator.clear();
         };
 
@@ -76,35 +123,124 @@ void Application::createButtons()
     }
 }
 
+void Application::createTerrainEditor()
+{
+    // A running search goes on against each new version of the surface
+    auto callback = [this] (std::shared_ptr<const PreparedLevel> level)
+    {
+        m_levelLoader.setLevel(level);
+        m_simulator.updateLevel(std::move(level));
+        m_isStaticLayerDirty = true;
+        m_needsRedraw = true;
+    };
+
+    m_terrainEditor.setLevel(m_levelLoader.preparedLevel());
+    m_terrainEditor.setEditedCallback(callback);
+}
+
 void Application::processInput()
 {
     sf::Event event;
     while (m_window.pollEvent(event))
     {
-        if (event.type == sf::Event::Closed)
-            m_window.close();
+        handleEvent(event);
+    }
+}
+
+void Application::handleEvent(const sf::Event& event)
+{
+    if (event.type == sf::Event::Closed)
+        m_window.close();
+
+    // Export the control sequence of the landing
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::S && m_simulator.hasLanded())
+        m_simulator.saveReplay("solution.replay");
+
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::H)
+    {
+        m_performanceHud.toggle();
+        m_needsRedraw = true;
+    }
+
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::E)
+    {
+        m_terrainEditor.toggle();
+        m_needsRedraw = true;
+    }
+
+    // The clicks on the surface go to the editor, the other ones to the buttons
+    if (m_terrainEditor.handleEvent(event))
+        return;
+
+    bool isSimulationRunning = m_simulator.status() == Simulator::Status::RUNNING;
+    m_container.handleEvent(event, isSimulationRunning);
 
-        bool isSimulationRunning = m_simulator.status() == Simulator::Status::RUNNING;
-        m_container.handleEvent(event, isSimulationRunning);
+    // A click may have loaded another level, and the window may have been
+    // uncovered : draw everything again
+    if (event.type == sf::Event::MouseButtonPressed || event.type == sf::Event::GainedFocus || event.type == sf::Event::Resized)
+    {
+        m_isStaticLayerDirty = true;
+        m_needsRedraw = true;
     }
 }
 
 void Application::update(sf::Time dt)
 {
-    m_simulator.update(dt);
-    m_container.update(dt);
+    m_needsRedraw |= m_simulator.update(dt);
+
+    if (m_container.update(dt))
+    {
+        m_isStaticLayerDirty = true;
+        m_needsRedraw = true;
+    }
+
+    if (m_simulator.numberOfIterations() != m_displayedIterations)
+    {
+        m_displayedIterations = m_simulator.numberOfIterations();
+        m_statisticsText.setString("Number of iterations : " + std::to_string(m_displayedIterations));
+        m_needsRedraw = true;
+    }
 
-    m_statisticsText.setString("Number of iterations : " + std::to_string(m_simulator.numberOfIterations()));
+    m_needsRedraw |= m_performanceHud.update(dt, m_simulator);
 }
 
 void Application::render()
 {
+    if (m_isStaticLayerDirty)
+    {
+        renderStaticLayer();
+    }
+
+    sf::Clock clock;
     m_window.clear();
 
-    m_levelLoader.render(m_window);
+    m_window.draw(m_staticSprite);
+    m_window.draw(m_terrainEditor);
     m_simulator.render(m_window);
-    m_window.draw(m_container);
     m_window.draw(m_statisticsText);
+    m_window.draw(m_performanceHud);
 
     m_window.display();
+    m_needsRedraw = false;
+    m_performanceHud.recordFrame(clock.getElapsedTime());
+}
+
+void Application::renderStaticLayer()
+{
+    m_staticLayer.clear();
+
+    m_levelLoader.render(m_staticLayer);
+    m_staticLayer.draw(m_container);
+
+    m_staticLayer.display();
+    m_isStaticLayerDirty = false;
+}
+
+void Application::reportCpuUsage() const
+{
+    const double cpuSeconds = static_cast<double>(std::clock() - m_cpuStart) / CLOCKS_PER_SEC;
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_wallStart).count();
+
+    std::cout << "CPU usage : " << cpuSeconds << " s over " << wallSeconds << " s ("
+              << static_cast<int>(100.0 * cpuSeconds / std::max(wallSeconds, 1e-9) + 0.5) << "% of a core)" << std::endl;
 }
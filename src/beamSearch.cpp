@@ -0,0 +1,333 @@
+#include "beamSearch.hpp"
+#include "controllerSeeding.hpp"
+#include "rollout.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // Turn of each step of an action, up to the limit of the lander
+    const int s_angleChanges[] = {-15, -5, 0, 5, 15};
+    const int s_thrustChanges[] = {-1, 0, 1};
+    const std::uint16_t s_numberOfActions = 15;
+}
+
+BeamSearch::BeamSearch(const BeamSearchConfig& config, std::size_t maxSteps)
+    : m_config(config)
+    , m_maxSteps(maxSteps)
+    , m_width(0)
+    , m_solutionSteps(0)
+    , m_numberOfRollouts(0)
+    , m_numberOfSteps(0)
+    , m_numberOfCollisionTests(0)
+    , m_pool(config.threads, config.pinning)
+{
+    m_config.stepsPerAction = std::max<std::size_t>(1, m_config.stepsPerAction);
+    m_config.width = std::max<std::size_t>(1, m_config.width);
+    m_config.maxWidth = std::max(m_config.width, m_config.maxWidth);
+    m_width = m_config.width;
+}
+
+BeamSearch::~BeamSearch()
+{
+
+}
+
+void BeamSearch::start(const Lander& lander, std::shared_ptr<const PreparedLevel> level)
+{
+    m_lander = lander;
+    m_level = std::move(level);
+    m_width = m_config.width;
+    m_solution.clear();
+    m_solutionSteps = 0;
+    m_numberOfRollouts = 0;
+    m_numberOfSteps = 0;
+    m_numberOfCollisionTests = 0;
+
+    restart();
+}
+
+void BeamSearch::restart()
+{
+    m_nodes.clear();
+    m_beam.clear();
+    m_beamTails.clear();
+    m_visitedStates.clear();
+
+    m_nodes.push_back(Node{m_lander, -1, 0, 0, 0.0});
+    m_beam.push_back(0);
+    m_visitedStates.insert(stateKey(m_lander));
+}
+
+bool BeamSearch::expand()
+{
+    std::vector<Child> children;
+    children.reserve(m_beam.size() * s_numberOfActions);
+
+    for (std::int32_t parent : m_beam)
+    {
+        for (std::uint16_t action = 0; action < s_numberOfActions; ++action)
+        {
+            Child child = applyAction(parent, action);
+            m_numberOfSteps += child.steps;
+            m_numberOfCollisionTests += child.collisionTests;
+
+            if (child.hasLanded)
+            {
+                m_nodes.push_back(child.node);
+                m_solution = plan(static_cast<std::int32_t>(m_nodes.size() - 1));
+                m_solutionSteps = child.landingSteps;
+                return true;
+            }
+
+            // Transpositions : the same state reached by another plan is only kept once
+            if (child.isFlying && m_visitedStates.insert(stateKey(child.node.lander)).second)
+            {
+                children.push_back(child);
+            }
+        }
+    }
+
+    flyRollouts(children);
+
+    for (const Child& child : children)
+    {
+        m_numberOfRollouts++;
+        m_numberOfSteps += child.steps;
+        m_numberOfCollisionTests += child.collisionTests;
+    }
+
+    // The first landing in the order of the children, whatever thread flew it
+    for (const Child& child : children)
+    {
+        if (child.hasLanded)
+        {
+            m_nodes.push_back(child.node);
+            m_solution = plan(static_cast<std::int32_t>(m_nodes.size() - 1));
+            m_solution.insert(m_solution.end(), child.tail.begin(), child.tail.end());
+            m_solutionSteps = child.landingSteps;
+            return true;
+        }
+    }
+
+    // Ties keep the order of the children, so that the search is reproducible
+    std::stable_sort(children.begin(), children.end(), [] (const Child& a, const Child& b)
+    {
+        return a.node.score > b.node.score;
+    });
+
+    m_beam.clear();
+    m_beamTails.clear();
+    for (std::size_t i = 0; i < children.size() && i < m_width; ++i)
+    {
+        m_beam.push_back(static_cast<std::int32_t>(m_nodes.size()));
+        m_beamTails.push_back(std::move(children[i].tail));
+        m_nodes.push_back(children[i].node);
+    }
+
+    // Every plan crashed or ran out of steps : start over with a wider beam,
+    // up to the widest one allowed
+    if (m_beam.empty())
+    {
+        if (m_width >= m_config.maxWidth)
+        {
+            throw std::runtime_error("BeamSearch::expand - No plan lands with a beam of " + std::to_string(m_width) + " states");
+        }
+
+        m_width = std::min(2 * m_width, m_config.maxWidth);
+        restart();
+    }
+
+    return false;
+}
+
+BeamSearch::Child BeamSearch::applyAction(std::int32_t parent, std::uint16_t action) const
+{
+    const Node& parentNode = m_nodes[parent];
+    Child child;
+    child.node = Node{parentNode.lander, parent, action, static_cast<std::uint16_t>(parentNode.depth + 1), 0.0};
+
+    const Terrain& terrain = m_level->terrain;
+    const Polyline& landingLine = terrain.landingLine();
+    Lander& lander = child.node.lander;
+
+    // Every step of the action applies the same deltas
+    const Gene gene = actionGene(action);
+    std::size_t step = parentNode.depth * m_config.stepsPerAction;
+    for (std::size_t i = 0; i < m_config.stepsPerAction; ++i, ++step)
+    {
+        if (step >= m_maxSteps)
+        {
+            child.isFlying = false;
+            return child;
+        }
+
+        lander.simulationStep(gene.angle, gene.thrust);
+        child.steps++;
+
+        const std::optional<Point2d> impact = terrain.intersection(lander.previousPosition(), lander.position(), child.collisionTests);
+        if (impact)
+        {
+            child.isFlying = false;
+            child.hasLanded = impact.value().x >= landingLine[0].x &&
+                              impact.value().x <= landingLine[1].x &&
+                              lander.hasSafelyLanded();
+            child.landingSteps = step + 1;
+            return child;
+        }
+
+        if (!lander.canStillLand())
+        {
+            child.isFlying = false;
+            return child;
+        }
+    }
+
+    child.isFlying = terrain.canReachLanding(lander);
+    return child;
+}
+
+void BeamSearch::flyRollouts(std::vector<Child>& children)
+{
+    const std::size_t numberOfThreads = m_pool.size();
+
+    // Each thread takes every n-th child and writes only to it
+    m_pool.run([this, &children, numberOfThreads] (std::size_t first)
+    {
+        for (std::size_t i = first; i < children.size(); i += numberOfThreads)
+        {
+            flyRollout(children[i]);
+        }
+    });
+}
+
+void BeamSearch::flyRollout(Child& child) const
+{
+    // The rest of the flight is left to the PD controller of the seeding, with
+    // gains drawn from the state so that the same child always flies the same way
+    const std::size_t firstStep = child.node.depth * m_config.stepsPerAction;
+    const std::size_t remainingSteps = m_maxSteps - firstStep;
+    utils::RandomEngine engine(static_cast<utils::RandomEngine::result_type>(StateKeyHash()(stateKey(child.node.lander))));
+    Phenotype tail = ControllerSeeder(ControlEncoding(), remainingSteps).genome(child.node.lander, m_level->terrain, engine);
+    const RolloutResult<double> result = rollout(child.node.lander, tail, m_level->terrain, [] (const Point2d&) {});
+
+    child.steps = result.steps;
+    child.collisionTests = result.collisionTests;
+    child.hasLanded = result.hasLanded;
+    child.landingSteps = firstStep + result.steps;
+    child.tail = std::move(tail.genes());
+
+    Phenotype scored(std::vector<Gene>(), 0.0);
+    scored.computeScore(result.lander, m_level->terrain);
+    child.node.score = scored.score();
+}
+
+std::vector<Gene> BeamSearch::plan(std::int32_t node) const
+{
+    std::vector<Gene> genes(m_nodes[node].depth * m_config.stepsPerAction);
+
+    for (std::int32_t id = node; m_nodes[id].parent >= 0; id = m_nodes[id].parent)
+    {
+        const std::size_t firstStep = (m_nodes[id].depth - 1) * m_config.stepsPerAction;
+        std::fill_n(genes.begin() + firstStep, m_config.stepsPerAction, actionGene(m_nodes[id].action));
+    }
+
+    return genes;
+}
+
+Gene BeamSearch::actionGene(std::uint16_t action) noexcept
+{
+    const int angle = s_angleChanges[action / 3];
+    const int thrust = s_thrustChanges[action % 3];
+
+    return Gene{static_cast<std::int8_t>(angle), static_cast<std::int8_t>(thrust)};
+}
+
+BeamSearch::StateKey BeamSearch::stateKey(const Lander& lander) noexcept
+{
+    // Metres, half metres per second, degrees, thrust and tens of litres of fuel
+    return StateKey{{
+        static_cast<std::int64_t>(std::floor(lander.position().x)),
+        static_cast<std::int64_t>(std::floor(lander.position().y)),
+        static_cast<std::int64_t>(std::floor(2.0 * lander.velocity().x)),
+        static_cast<std::int64_t>(std::floor(2.0 * lander.velocity().y)),
+        lander.angle(),
+        lander.thrust(),
+        lander.fuel() / 10
+    }};
+}
+
+std::size_t BeamSearch::StateKeyHash::operator()(const StateKey& key) const noexcept
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::int64_t value : key.values)
+    {
+        hash ^= static_cast<std::uint64_t>(value);
+        hash *= 1099511628211ull;
+        hash ^= hash >> 29;
+    }
+
+    return static_cast<std::size_t>(hash);
+}
+
+std::vector<Phenotype> BeamSearch::population() const
+{
+    // Each plan goes on with the commands of its rollout, so that the genome
+    // flies the trajectory its score comes from. Only the start of a search has
+    // no rollout : it holds its commands with a score of 0, and is left out
+    // once a landing is found.
+    std::vector<Phenotype> population;
+    population.reserve(m_beam.size() + 1);
+
+    if (!m_solution.empty())
+    {
+        std::vector<Gene> genes = m_solution;
+        genes.resize(std::max(genes.size(), m_maxSteps), Gene{0, 0});
+        population.emplace_back(std::move(genes), 100.0);
+    }
+
+    for (std::size_t i = 0; i < m_beam.size(); ++i)
+    {
+        const std::int32_t node = m_beam[i];
+        if (!m_solution.empty() && m_nodes[node].depth == 0)
+            continue;
+
+        std::vector<Gene> genes = plan(node);
+        if (i < m_beamTails.size())
+        {
+            genes.insert(genes.end(), m_beamTails[i].begin(), m_beamTails[i].end());
+        }
+        genes.resize(std::max(genes.size(), m_maxSteps), Gene{0, 0});
+        population.emplace_back(std::move(genes), m_nodes[node].score);
+    }
+
+    return population;
+}
+
+std::size_t BeamSearch::solutionSteps() const noexcept
+{
+    return m_solutionSteps;
+}
+
+std::size_t BeamSearch::width() const noexcept
+{
+    return m_width;
+}
+
+std::size_t BeamSearch::numberOfRollouts() const noexcept
+{
+    return m_numberOfRollouts;
+}
+
+std::size_t BeamSearch::numberOfSteps() const noexcept
+{
+    return m_numberOfSteps;
+}
+
+std::size_t BeamSearch::numberOfCollisionTests() const noexcept
+{
+    return m_numberOfCollisionTests;
+}
@@ -11,12 +11,14 @@ Button::Button(FontHolder& fontHolder, std::string text)
     , m_text(text, fontHolder.get(Fonts::ID::Upheaval), 15)
     , m_timer(sf::Time::Zero)
     , m_showText(true)
+    , m_isHighlighted(false)
 {
     m_shape.setSize(sf::Vector2f(70, 30));
     m_shape.setOutlineThickness(1.0f);
     m_shape.setOutlineColor(sf::Color::Green);
     utils::centerOrigin(m_text);
     m_text.setPosition(sf::Vector2f(getPosition().x + m_shape.getSize().x / 2, getPosition().y + m_shape.getSize().y / 2));
+    m_text.setFillColor(sf::Color::Black);
 }
 
 Button::~Button()
@@ -78,11 +80,12 @@ void Button::draw(sf::RenderTarget& target, sf::RenderStates states) const
     target.draw(m_text, transform);
 }
 
-void Button::update(sf::Time dt, const sf::RenderWindow& window)
+bool Button::update(sf::Time dt, const sf::RenderWindow& window)
 {
     m_timer += dt;
 
-    if (isSelected(window))
+    const bool isHighlighted = isSelected(window);
+    if (isHighlighted)
     {
         m_text.setFillColor(sf::Color::Yellow);
     }
@@ -90,6 +93,11 @@ void Button::update(sf::Time dt, const sf::RenderWindow& window)
     {
         m_text.setFillColor(sf::Color::Black);
     }
+
+    const bool hasChanged = isHighlighted != m_isHighlighted;
+    m_isHighlighted = isHighlighted;
+
+    return hasChanged;
 }
 
 bool Button::isSelected(const sf::RenderWindow& window) const
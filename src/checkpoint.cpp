@@ -0,0 +1,254 @@
+#include "checkpoint.hpp"
+#include "binaryStream.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    const char s_magic[4] = {'M', 'L', 'C', 'P'};
+    const std::uint32_t s_version = 13;
+
+    // An enumerator past the last one is not from this version of the format
+    template <typename T>
+    T readEnum(std::istream& stream, T last)
+    {
+        const T value = utils::readBinary<T>(stream);
+        if (static_cast<std::uint64_t>(value) > static_cast<std::uint64_t>(last))
+        {
+            throw std::runtime_error("readCheckpoint - Not a checkpoint of this version");
+        }
+
+        return value;
+    }
+}
+
+void writeCheckpoint(std::ostream& stream, const Checkpoint& checkpoint)
+{
+    stream.write(s_magic, sizeof(s_magic));
+    utils::writeBinary(stream, s_version);
+    utils::writeBinary(stream, checkpoint.levelHash);
+
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.populationSize);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.geneLength);
+    utils::writeBinary(stream, checkpoint.config.crossoverRate);
+    utils::writeBinary(stream, checkpoint.config.mutationRate);
+    utils::writeBinary(stream, checkpoint.config.seed);
+    utils::writeBinary(stream, checkpoint.config.strategy);
+    utils::writeBinary(stream, checkpoint.config.selection);
+    utils::writeBinary(stream, checkpoint.config.niching.method);
+    utils::writeBinary(stream, checkpoint.config.niching.radius);
+    utils::writeBinary(stream, checkpoint.config.niching.approximation);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.niching.samples);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.encoding.stepsPerGene);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.encoding.maxSteps);
+    utils::writeBinary(stream, checkpoint.config.seedingFraction);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.localSearch.individuals);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.localSearch.tailGenes);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.localSearch.evaluations);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.robustness.samples);
+    utils::writeBinary(stream, checkpoint.config.robustness.positionNoise);
+    utils::writeBinary(stream, checkpoint.config.robustness.velocityNoise);
+    utils::writeBinary<std::int32_t>(stream, checkpoint.config.robustness.fuelNoise);
+    utils::writeBinary(stream, checkpoint.config.robustness.quantile);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.robustness.threads);
+    utils::writeBinary(stream, checkpoint.config.robustness.pinning);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.beamSearch.width);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.beamSearch.maxWidth);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.beamSearch.stepsPerAction);
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.config.beamSearch.threads);
+    utils::writeBinary(stream, checkpoint.config.beamSearch.pinning);
+
+    utils::writeBinary(stream, checkpoint.numberOfIterations);
+    utils::writeBinary(stream, checkpoint.numberOfEvaluations);
+    utils::writeBinary(stream, checkpoint.numberOfSteps);
+    utils::writeBinary(stream, checkpoint.numberOfCollisionTests);
+    utils::writeBinaryString(stream, checkpoint.randomEngineState);
+    utils::writeBinaryString(stream, checkpoint.strategyState);
+
+    utils::writeBinary<std::uint64_t>(stream, checkpoint.population.size());
+    for (const Phenotype& phenotype : checkpoint.population)
+    {
+        utils::writeBinary(stream, phenotype.score());
+        utils::writeBinary<std::uint32_t>(stream, static_cast<std::uint32_t>(phenotype.size()));
+        stream.write(reinterpret_cast<const char*>(phenotype.genes().data()), phenotype.size() * sizeof(Gene));
+    }
+}
+
+Checkpoint readCheckpoint(std::istream& stream)
+{
+    char magic[4];
+    stream.read(magic, sizeof(magic));
+    if (!stream || !std::equal(magic, magic + 4, s_magic) || utils::readBinary<std::uint32_t>(stream) != s_version)
+    {
+        throw std::runtime_error("readCheckpoint - Not a checkpoint of this version");
+    }
+
+    Checkpoint checkpoint;
+    checkpoint.levelHash = utils::readBinary<std::uint64_t>(stream);
+
+    checkpoint.config.populationSize = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.geneLength = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.crossoverRate = utils::readBinary<double>(stream);
+    checkpoint.config.mutationRate = utils::readBinary<double>(stream);
+    checkpoint.config.seed = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.strategy = readEnum(stream, StrategyType::BEAM_SEARCH);
+    checkpoint.config.selection = readEnum(stream, SelectionMethod::ROULETTE);
+    checkpoint.config.niching.method = readEnum(stream, NichingMethod::CROWDING);
+    checkpoint.config.niching.radius = utils::readBinary<double>(stream);
+    checkpoint.config.niching.approximation = readEnum(stream, NichingApproximation::LSH);
+    checkpoint.config.niching.samples = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.encoding.stepsPerGene = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.encoding.maxSteps = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.seedingFraction = utils::readBinary<double>(stream);
+    checkpoint.config.localSearch.individuals = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.localSearch.tailGenes = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.localSearch.evaluations = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.robustness.samples = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.robustness.positionNoise = utils::readBinary<double>(stream);
+    checkpoint.config.robustness.velocityNoise = utils::readBinary<double>(stream);
+    checkpoint.config.robustness.fuelNoise = utils::readBinary<std::int32_t>(stream);
+    checkpoint.config.robustness.quantile = utils::readBinary<double>(stream);
+    checkpoint.config.robustness.threads = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.robustness.pinning = readEnum(stream, PinningPolicy::SCATTER);
+    checkpoint.config.beamSearch.width = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.beamSearch.maxWidth = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.beamSearch.stepsPerAction = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.beamSearch.threads = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.config.beamSearch.pinning = readEnum(stream, PinningPolicy::SCATTER);
+
+    checkpoint.numberOfIterations = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.numberOfEvaluations = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.numberOfSteps = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.numberOfCollisionTests = utils::readBinary<std::uint64_t>(stream);
+    checkpoint.randomEngineState = utils::readBinaryString(stream);
+    checkpoint.strategyState = utils::readBinaryString(stream);
+
+    const std::uint64_t populationSize = utils::readBinary<std::uint64_t>(stream);
+    for (std::uint64_t i = 0; i < populationSize && stream; ++i)
+    {
+        const double score = utils::readBinary<double>(stream);
+        std::vector<Gene> genes(utils::readBinaryCount<std::uint32_t>(stream, sizeof(Gene)));
+        stream.read(reinterpret_cast<char*>(genes.data()), genes.size() * sizeof(Gene));
+        checkpoint.population.emplace_back(std::move(genes), score);
+    }
+
+    if (!stream)
+    {
+        throw std::runtime_error("readCheckpoint - Truncated checkpoint");
+    }
+
+    return checkpoint;
+}
+
+void saveCheckpoint(const Checkpoint& checkpoint, const std::string& fileName)
+{
+    // Write next to the destination then rename, so that a crash during the
+    // write never leaves a truncated checkpoint behind
+    const std::string temporaryFileName = fileName + ".tmp";
+
+    {
+        std::ofstream file(temporaryFileName, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            throw std::runtime_error("saveCheckpoint - Failed to open " + temporaryFileName);
+        }
+
+        writeCheckpoint(file, checkpoint);
+
+        if (!file)
+        {
+            throw std::runtime_error("saveCheckpoint - Failed to write " + temporaryFileName);
+        }
+    }
+
+    if (std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+    {
+        // Some platforms refuse to rename over an existing file
+        std::remove(fileName.c_str());
+        if (std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+        {
+            throw std::runtime_error("saveCheckpoint - Failed to replace " + fileName);
+        }
+    }
+}
+
+Checkpoint loadCheckpoint(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("loadCheckpoint - Failed to load " + fileName);
+    }
+
+    try
+    {
+        return readCheckpoint(file);
+    }
+    catch (const std::runtime_error& e)
+    {
+        throw std::runtime_error("loadCheckpoint - " + fileName + " : " + e.what());
+    }
+}
+
+CheckpointWriter::CheckpointWriter(const std::string& fileName)
+    : m_fileName(fileName)
+    , m_isStopping(false)
+    , m_thread(&CheckpointWriter::writeLoop, this)
+{
+
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+void CheckpointWriter::submit(Checkpoint checkpoint)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = std::move(checkpoint);
+    }
+    m_condition.notify_one();
+}
+
+const std::string& CheckpointWriter::fileName() const noexcept
+{
+    return m_fileName;
+}
+
+void CheckpointWriter::writeLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_condition.wait(lock, [this] () { return m_pending || m_isStopping; });
+
+        if (!m_pending)
+            return;
+
+        Checkpoint checkpoint = std::move(m_pending.value());
+        m_pending.reset();
+
+        lock.unlock();
+        try
+        {
+            saveCheckpoint(checkpoint, m_fileName);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "CheckpointWriter - " << e.what() << std::endl;
+        }
+        lock.lock();
+    }
+}
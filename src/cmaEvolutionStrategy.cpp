@@ -0,0 +1,176 @@
+#include "cmaEvolutionStrategy.hpp"
+#include "binaryStream.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+double CmaEvolutionStrategy::s_initialStepSize = 0.3;
+
+CmaEvolutionStrategy::CmaEvolutionStrategy(const SolverConfig& config)
+    : SearchStrategy(config)
+    , m_stepSize(s_initialStepSize)
+    , m_generation(0)
+{
+    const double n = static_cast<double>(dimension());
+    const std::size_t mu = std::max<std::size_t>(1, config.populationSize / 2);
+
+    for (std::size_t i = 0; i < mu; ++i)
+    {
+        m_weights.push_back(std::log(mu + 0.5) - std::log(i + 1.0));
+    }
+    const double sum = std::accumulate(m_weights.begin(), m_weights.end(), 0.0);
+    double sumOfSquares = 0.0;
+    for (double& weight : m_weights)
+    {
+        weight /= sum;
+        sumOfSquares += weight * weight;
+    }
+    m_effectiveMu = 1.0 / sumOfSquares;
+
+    m_stepSizeLearningRate = (m_effectiveMu + 2.0) / (n + m_effectiveMu + 5.0);
+    m_stepSizeDamping = 1.0 + 2.0 * std::max(0.0, std::sqrt((m_effectiveMu - 1.0) / (n + 1.0)) - 1.0) + m_stepSizeLearningRate;
+    m_pathLearningRate = (4.0 + m_effectiveMu / n) / (n + 4.0 + 2.0 * m_effectiveMu / n);
+
+    // The diagonal covariance can be learnt (n + 2) / 3 times faster than a full one
+    const double rankOne = 2.0 / ((n + 1.3) * (n + 1.3) + m_effectiveMu);
+    const double rankMu = std::min(1.0 - rankOne, 2.0 * (m_effectiveMu - 2.0 + 1.0 / m_effectiveMu) / ((n + 2.0) * (n + 2.0) + m_effectiveMu));
+    m_rankOneLearningRate = std::min(1.0, rankOne * (n + 2.0) / 3.0);
+    m_rankMuLearningRate = std::min(1.0 - m_rankOneLearningRate, rankMu * (n + 2.0) / 3.0);
+
+    m_expectedNorm = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+}
+
+CmaEvolutionStrategy::~CmaEvolutionStrategy()
+{
+
+}
+
+std::vector<Phenotype> CmaEvolutionStrategy::initialPopulation(utils::RandomEngine& engine)
+{
+    m_mean.assign(dimension(), 0.0);
+    m_variances.assign(dimension(), 1.0);
+    m_stepSizePath.assign(dimension(), 0.0);
+    m_covariancePath.assign(dimension(), 0.0);
+    m_stepSize = s_initialStepSize;
+    m_generation = 0;
+
+    std::vector<Phenotype> population;
+    sample(population, engine);
+
+    return population;
+}
+
+void CmaEvolutionStrategy::sample(std::vector<Phenotype>& population, utils::RandomEngine& engine)
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<double> point(dimension());
+
+    m_samples.resize(m_config.populationSize);
+    for (std::vector<double>& z : m_samples)
+    {
+        z.resize(dimension());
+        for (std::size_t j = 0; j < z.size(); ++j)
+        {
+            z[j] = normal(engine);
+            point[j] = m_mean[j] + m_stepSize * std::sqrt(m_variances[j]) * z[j];
+        }
+
+        population.push_back(decode(point));
+    }
+}
+
+void CmaEvolutionStrategy::nextPopulation(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine)
+{
+    const std::size_t n = dimension();
+
+    std::vector<std::size_t> ranking(evaluated.size());
+    std::iota(ranking.begin(), ranking.end(), 0);
+    std::stable_sort(ranking.begin(), ranking.end(), [&evaluated] (std::size_t a, std::size_t b)
+    {
+        return evaluated[a].score() > evaluated[b].score();
+    });
+
+    // Weighted recombination of the best samples
+    std::vector<double> meanStep(n, 0.0);
+    std::vector<double> meanSample(n, 0.0);
+    for (std::size_t i = 0; i < m_weights.size(); ++i)
+    {
+        const std::vector<double>& z = m_samples[ranking[i]];
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            meanSample[j] += m_weights[i] * z[j];
+            meanStep[j] += m_weights[i] * std::sqrt(m_variances[j]) * z[j];
+        }
+    }
+
+    // Evolution paths
+    const double stepSizeFactor = std::sqrt(m_stepSizeLearningRate * (2.0 - m_stepSizeLearningRate) * m_effectiveMu);
+    double pathNorm = 0.0;
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        m_mean[j] += m_stepSize * meanStep[j];
+        m_stepSizePath[j] = (1.0 - m_stepSizeLearningRate) * m_stepSizePath[j] + stepSizeFactor * meanSample[j];
+        pathNorm += m_stepSizePath[j] * m_stepSizePath[j];
+    }
+    pathNorm = std::sqrt(pathNorm);
+
+    m_generation++;
+    const double pathCorrection = std::sqrt(1.0 - std::pow(1.0 - m_stepSizeLearningRate, 2.0 * m_generation));
+    const bool isPathStalled = pathNorm / pathCorrection / m_expectedNorm >= 1.4 + 2.0 / (n + 1.0);
+    const double covarianceFactor = std::sqrt(m_pathLearningRate * (2.0 - m_pathLearningRate) * m_effectiveMu);
+
+    // Diagonal covariance update, rank one and rank mu
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        m_covariancePath[j] = (1.0 - m_pathLearningRate) * m_covariancePath[j] + (isPathStalled ? 0.0 : covarianceFactor * meanStep[j]);
+
+        double rankMuUpdate = 0.0;
+        for (std::size_t i = 0; i < m_weights.size(); ++i)
+        {
+            const double y = std::sqrt(m_variances[j]) * m_samples[ranking[i]][j];
+            rankMuUpdate += m_weights[i] * y * y;
+        }
+
+        const double stalledCorrection = isPathStalled ? m_pathLearningRate * (2.0 - m_pathLearningRate) * m_variances[j] : 0.0;
+        m_variances[j] = (1.0 - m_rankOneLearningRate - m_rankMuLearningRate) * m_variances[j]
+                       + m_rankOneLearningRate * (m_covariancePath[j] * m_covariancePath[j] + stalledCorrection)
+                       + m_rankMuLearningRate * rankMuUpdate;
+    }
+
+    m_stepSize *= std::exp((m_stepSizeLearningRate / m_stepSizeDamping) * (pathNorm / m_expectedNorm - 1.0));
+
+    sample(next, engine);
+}
+
+void CmaEvolutionStrategy::saveState(std::ostream& stream) const
+{
+    utils::writeBinaryVector(stream, m_mean);
+    utils::writeBinaryVector(stream, m_variances);
+    utils::writeBinaryVector(stream, m_stepSizePath);
+    utils::writeBinaryVector(stream, m_covariancePath);
+    utils::writeBinary(stream, m_stepSize);
+    utils::writeBinary(stream, m_generation);
+
+    utils::writeBinary<std::uint64_t>(stream, m_samples.size());
+    for (const std::vector<double>& z : m_samples)
+    {
+        utils::writeBinaryVector(stream, z);
+    }
+}
+
+void CmaEvolutionStrategy::loadState(std::istream& stream)
+{
+    m_mean = utils::readBinaryVector<double>(stream);
+    m_variances = utils::readBinaryVector<double>(stream);
+    m_stepSizePath = utils::readBinaryVector<double>(stream);
+    m_covariancePath = utils::readBinaryVector<double>(stream);
+    m_stepSize = utils::readBinary<double>(stream);
+    m_generation = utils::readBinary<std::uint64_t>(stream);
+
+    m_samples.resize(utils::readBinary<std::uint64_t>(stream));
+    for (std::vector<double>& z : m_samples)
+    {
+        z = utils::readBinaryVector<double>(stream);
+    }
+}
@@ -50,10 +50,13 @@ void Container::draw(sf::RenderTarget& target, sf::RenderStates states) const
     }
 }
 
-void Container::update(sf::Time dt)
+bool Container::update(sf::Time dt)
 {
+    bool hasChanged = false;
     for (const std::shared_ptr<Button>& button : m_buttons)
     {
-        button->update(dt, m_window);
+        hasChanged |= button->update(dt, m_window);
     }
+
+    return hasChanged;
 }
@@ -0,0 +1,140 @@
+#include "controllerSeeding.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    const double s_pi = 3.14159265358979323846;
+
+    struct Gains
+    {
+        // Height kept above the highest ground on the way
+        double cruiseMargin;
+        double maxHorizontalSpeed;
+        // Horizontal speed asked per metre to the middle of the landing area
+        double positionGain;
+        // Acceleration asked per m/s of speed error
+        double velocityGain;
+        // Descent speed asked per metre above the landing area, and its limit
+        double descentGain;
+        double maxDescentSpeed;
+    };
+
+    Gains randomGains(utils::RandomEngine& engine)
+    {
+        return {utils::uniform(engine, 100.0, 400.0),
+                utils::uniform(engine, 20.0, 80.0),
+                utils::uniform(engine, 0.02, 0.1),
+                utils::uniform(engine, 0.3, 1.0),
+                utils::uniform(engine, 0.05, 0.2),
+                utils::uniform(engine, 15.0, 35.0)};
+    }
+
+    int stepDelta(int difference, int steps)
+    {
+        const int magnitude = (std::abs(difference) + steps - 1) / steps;
+        return difference < 0 ? -magnitude : magnitude;
+    }
+
+    // Highest ground between two abscissas
+    double highestGround(const Terrain& terrain, double a, double b)
+    {
+        const Polyline& surface = terrain.surfacePoints();
+        const double left = std::min(a, b);
+        const double right = std::max(a, b);
+
+        double height = -1.0;
+        for (std::size_t i = 0; i + 1 < surface.size(); ++i)
+        {
+            if (std::max(surface[i].x, surface[i + 1].x) >= left && std::min(surface[i].x, surface[i + 1].x) <= right)
+            {
+                height = std::max({height, surface[i].y, surface[i + 1].y});
+            }
+        }
+
+        return height;
+    }
+}
+
+ControllerSeeder::ControllerSeeder(const ControlEncoding& encoding, std::size_t geneLength)
+    : m_encoding(encoding)
+    , m_numberOfGenes(encoding.numberOfGenes(geneLength))
+{
+
+}
+
+ControllerSeeder::~ControllerSeeder()
+{
+
+}
+
+Phenotype ControllerSeeder::genome(const Lander& lander, const Terrain& terrain, utils::RandomEngine& engine) const
+{
+    const Gains gains = randomGains(engine);
+    const Polyline& landingLine = terrain.landingLine();
+    const double targetX = (landingLine[0].x + landingLine[1].x) / 2.0;
+    const double halfWidth = std::abs(landingLine[1].x - landingLine[0].x) / 2.0;
+    const double landingY = landingLine[0].y;
+    const int stepsPerGene = static_cast<int>(m_encoding.stepsPerGene);
+
+    std::vector<Gene> genes(m_numberOfGenes, Gene{0, 0});
+    Lander flight = lander;
+
+    for (std::size_t id = 0; id < m_numberOfGenes; ++id)
+    {
+        const Point2d& position = flight.position();
+        const Point2d& velocity = flight.velocity();
+        const double distance = targetX - position.x;
+        const double height = position.y - landingY;
+
+        // Over the landing area and slow enough, it comes down. Otherwise it
+        // holds a cruise altitude above the ground left to fly over.
+        const double targetSpeedX = std::clamp(gains.positionGain * distance, -gains.maxHorizontalSpeed, gains.maxHorizontalSpeed);
+        double targetSpeedY = 0.0;
+        if (std::abs(distance) < 0.8 * halfWidth && std::abs(velocity.x) < 15.0)
+        {
+            targetSpeedY = -std::clamp(gains.descentGain * height, 10.0, gains.maxDescentSpeed);
+        }
+        else
+        {
+            const double cruise = highestGround(terrain, position.x, targetX) + gains.cruiseMargin;
+            targetSpeedY = std::clamp(0.1 * (cruise - position.y), -gains.maxDescentSpeed, 40.0);
+        }
+
+        const double accelerationX = gains.velocityGain * (targetSpeedX - velocity.x);
+        const double accelerationY = gains.velocityGain * (targetSpeedY - velocity.y) + Lander::s_gravity;
+
+        // The thrust points along the asked acceleration, but the lander tilts no
+        // more than what keeps the vertical part of it : a full thrust is only
+        // 0.29m/s² above the gravity. It stays upright for the touchdown.
+        const double tiltLimit = std::acos(std::clamp(accelerationY / 4.0, 0.0, 1.0)) * 180.0 / s_pi;
+        const double tilt = -std::atan2(accelerationX, std::max(accelerationY, 0.1)) * 180.0 / s_pi;
+        int targetAngle = static_cast<int>(std::lround(std::clamp(tilt, -tiltLimit, tiltLimit)));
+        if (height < 3.0 * std::abs(velocity.y) + 50.0 && std::abs(distance) < halfWidth)
+        {
+            targetAngle = 0;
+        }
+        const double thrustNeeded = targetAngle == std::lround(tilt) ? std::hypot(accelerationX, std::max(accelerationY, 0.0)) : 4.0;
+        const int targetThrust = std::clamp(static_cast<int>(std::lround(thrustNeeded)), 0, 4);
+
+        // A gene is applied at each of its steps : its delta is the smallest one
+        // which reaches the target by the end of them
+        Gene& gene = genes[id];
+        gene.angle = static_cast<std::int8_t>(std::clamp(stepDelta(targetAngle - flight.angle(), stepsPerGene), -15, 15));
+        gene.thrust = static_cast<std::int8_t>(std::clamp(stepDelta(targetThrust - flight.thrust(), stepsPerGene), -1, 1));
+
+        for (std::size_t step = 0; step < m_encoding.stepsPerGene; ++step)
+        {
+            flight.simulationStep(gene.angle, gene.thrust);
+
+            if (terrain.intersection(flight.previousPosition(), flight.position()))
+            {
+                return Phenotype(std::move(genes), 0.0);
+            }
+        }
+    }
+
+    return Phenotype(std::move(genes), 0.0);
+}
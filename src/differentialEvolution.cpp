@@ -0,0 +1,107 @@
+#include "differentialEvolution.hpp"
+#include "binaryStream.hpp"
+
+#include <algorithm>
+#include <limits>
+
+double DifferentialEvolution::s_differentialWeight = 0.5;
+double DifferentialEvolution::s_crossoverProbability = 0.9;
+
+DifferentialEvolution::DifferentialEvolution(const SolverConfig& config)
+    : SearchStrategy(config)
+{
+
+}
+
+DifferentialEvolution::~DifferentialEvolution()
+{
+
+}
+
+std::vector<Phenotype> DifferentialEvolution::initialPopulation(utils::RandomEngine& engine)
+{
+    m_targets.clear();
+    m_trials.clear();
+    // Any first trial beats an empty target
+    m_targetScores.assign(m_config.populationSize, -std::numeric_limits<double>::infinity());
+
+    std::vector<Phenotype> population;
+    for (std::size_t i = 0; i < m_config.populationSize; ++i)
+    {
+        m_trials.push_back(randomPoint(engine));
+        m_targets.push_back(m_trials.back());
+        population.push_back(decode(m_trials.back()));
+    }
+
+    return population;
+}
+
+void DifferentialEvolution::nextPopulation(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine)
+{
+    const std::size_t size = m_targets.size();
+
+    // Greedy selection between each target and its trial
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (evaluated[i].score() >= m_targetScores[i])
+        {
+            m_targets[i] = m_trials[i];
+            m_targetScores[i] = evaluated[i].score();
+        }
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        // Three distinct vectors, all different from the target
+        std::size_t r[3];
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            do
+            {
+                r[k] = utils::uniform(engine, 0, size - 1);
+            }
+            while (r[k] == i || std::find(r, r + k, r[k]) != r + k);
+        }
+
+        const std::vector<double>& target = m_targets[i];
+        std::vector<double>& trial = m_trials[i];
+        const std::size_t forcedIndex = utils::uniform(engine, 0, target.size() - 1);
+
+        for (std::size_t j = 0; j < target.size(); ++j)
+        {
+            if (j == forcedIndex || utils::uniform(engine, 0.0, 1.0) < s_crossoverProbability)
+            {
+                const double mutant = m_targets[r[0]][j] + s_differentialWeight * (m_targets[r[1]][j] - m_targets[r[2]][j]);
+                trial[j] = std::clamp(mutant, -1.0, 1.0);
+            }
+            else
+            {
+                trial[j] = target[j];
+            }
+        }
+
+        next.push_back(decode(trial));
+    }
+}
+
+void DifferentialEvolution::saveState(std::ostream& stream) const
+{
+    utils::writeBinaryVector(stream, m_targetScores);
+    for (std::size_t i = 0; i < m_targets.size(); ++i)
+    {
+        utils::writeBinaryVector(stream, m_targets[i]);
+        utils::writeBinaryVector(stream, m_trials[i]);
+    }
+}
+
+void DifferentialEvolution::loadState(std::istream& stream)
+{
+    m_targetScores = utils::readBinaryVector<double>(stream);
+    m_targets.resize(m_targetScores.size());
+    m_trials.resize(m_targetScores.size());
+    for (std::size_t i = 0; i < m_targets.size(); ++i)
+    {
+        m_targets[i] = utils::readBinaryVector<double>(stream);
+        m_trials[i] = utils::readBinaryVector<double>(stream);
+    }
+}
@@ -0,0 +1,542 @@
+#include "distributed.hpp"
+#include "binaryStream.hpp"
+#include "solver.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <poll.h>
+
+namespace
+{
+    const std::uint32_t s_protocolVersion = 1;
+
+    // Time a peer has to send the rest of a message, once it sent its first
+    // bytes : a new connection its hello, a worker its report
+    const double s_receiveTimeout = 5.0;
+
+    void writeLevel(std::ostream& stream, const Level& level)
+    {
+        utils::writeBinary(stream, level.data.position);
+        utils::writeBinary(stream, level.data.velocity);
+        utils::writeBinary<std::int32_t>(stream, level.data.fuel);
+        utils::writeBinary<std::int32_t>(stream, level.data.angle);
+        utils::writeBinary<std::int32_t>(stream, level.data.thrust);
+        utils::writeBinaryVector(stream, level.surfacePoints);
+    }
+
+    Level readLevel(std::istream& stream)
+    {
+        Level level;
+        level.data.position = utils::readBinary<Point2d>(stream);
+        level.data.velocity = utils::readBinary<Point2d>(stream);
+        level.data.fuel = utils::readBinary<std::int32_t>(stream);
+        level.data.angle = utils::readBinary<std::int32_t>(stream);
+        level.data.thrust = utils::readBinary<std::int32_t>(stream);
+        level.surfacePoints = utils::readBinaryVector<Point2d>(stream);
+
+        return level;
+    }
+
+    void writePhenotypes(std::ostream& stream, const std::vector<Phenotype>& phenotypes)
+    {
+        utils::writeBinary<std::uint64_t>(stream, phenotypes.size());
+        for (const Phenotype& phenotype : phenotypes)
+        {
+            utils::writeBinary(stream, phenotype.score());
+            utils::writeBinaryVector(stream, phenotype.genes());
+        }
+    }
+
+    std::vector<Phenotype> readPhenotypes(std::istream& stream)
+    {
+        std::vector<Phenotype> phenotypes;
+        const std::uint64_t size = utils::readBinary<std::uint64_t>(stream);
+        for (std::uint64_t i = 0; i < size && stream; ++i)
+        {
+            const double score = utils::readBinary<double>(stream);
+            phenotypes.emplace_back(utils::readBinaryVector<Gene>(stream), score);
+        }
+
+        return phenotypes;
+    }
+
+    std::string helloPayload()
+    {
+        std::ostringstream stream(std::ios::binary);
+        utils::writeBinary(stream, s_protocolVersion);
+        return stream.str();
+    }
+
+    std::vector<Phenotype> bestIndividuals(const std::vector<Phenotype>& population, std::size_t count)
+    {
+        std::vector<Phenotype> best = population;
+        count = std::min(count, best.size());
+
+        auto hasHigherScore = [] (const Phenotype& a, const Phenotype& b) { return a.score() > b.score(); };
+        std::partial_sort(best.begin(), best.begin() + count, best.end(), hasHigherScore);
+        best.resize(count);
+
+        return best;
+    }
+}
+
+bool sendMessage(Socket& socket, MessageType type, const std::string& payload)
+{
+    std::ostringstream header(std::ios::binary);
+    utils::writeBinary(header, type);
+    utils::writeBinary<std::uint64_t>(header, payload.size());
+
+    const std::string headerBytes = header.str();
+    return socket.sendAll(headerBytes.data(), headerBytes.size()) && socket.sendAll(payload.data(), payload.size());
+}
+
+std::optional<std::pair<MessageType, std::string>> receiveMessage(Socket& socket)
+{
+    MessageType type;
+    std::uint64_t size;
+    if (!socket.receiveAll(reinterpret_cast<char*>(&type), sizeof(type)) ||
+        !socket.receiveAll(reinterpret_cast<char*>(&size), sizeof(size)))
+    {
+        return std::nullopt;
+    }
+
+    // Checked before allocating, as the size comes from the peer
+    if (size > s_maxPayloadSize)
+    {
+        return std::nullopt;
+    }
+
+    std::string payload(size, '\0');
+    if (!socket.receiveAll(&payload[0], payload.size()))
+    {
+        return std::nullopt;
+    }
+
+    return std::make_pair(type, std::move(payload));
+}
+
+std::string encodeTask(const IslandTask& task)
+{
+    std::ostringstream stream(std::ios::binary);
+    utils::writeBinary(stream, task.island);
+    utils::writeBinary(stream, task.generations);
+    utils::writeBinary(stream, task.numberOfMigrants);
+    writeLevel(stream, task.level);
+    writeCheckpoint(stream, task.checkpoint);
+
+    return stream.str();
+}
+
+IslandTask decodeTask(const std::string& payload)
+{
+    std::istringstream stream(payload, std::ios::binary);
+
+    IslandTask task;
+    task.island = utils::readBinary<std::uint32_t>(stream);
+    task.generations = utils::readBinary<std::uint64_t>(stream);
+    task.numberOfMigrants = utils::readBinary<std::uint64_t>(stream);
+    task.level = readLevel(stream);
+    task.checkpoint = readCheckpoint(stream);
+
+    return task;
+}
+
+std::string encodeReport(const IslandReport& report)
+{
+    std::ostringstream stream(std::ios::binary);
+    utils::writeBinary(stream, report.island);
+    utils::writeBinary<std::uint8_t>(stream, report.hasLanded);
+    writeCheckpoint(stream, report.checkpoint);
+    writePhenotypes(stream, report.migrants);
+    utils::writeBinary(stream, report.replay.levelHash);
+    utils::writeBinary(stream, report.replay.seed);
+    utils::writeBinaryVector(stream, report.replay.genes);
+
+    return stream.str();
+}
+
+IslandReport decodeReport(const std::string& payload)
+{
+    std::istringstream stream(payload, std::ios::binary);
+
+    IslandReport report;
+    report.island = utils::readBinary<std::uint32_t>(stream);
+    report.hasLanded = utils::readBinary<std::uint8_t>(stream) != 0;
+    report.checkpoint = readCheckpoint(stream);
+    report.migrants = readPhenotypes(stream);
+    report.replay.levelHash = utils::readBinary<std::uint64_t>(stream);
+    report.replay.seed = utils::readBinary<std::uint64_t>(stream);
+    report.replay.genes = utils::readBinaryVector<Gene>(stream);
+
+    if (!stream)
+    {
+        throw std::runtime_error("decodeReport - Truncated report");
+    }
+
+    return report;
+}
+
+Coordinator::Coordinator(const CoordinatorConfig& config, const SolverConfig& solverConfig)
+    : m_config(config)
+    , m_solverConfig(solverConfig)
+    , m_server(Socket::listen(config.address))
+{
+
+}
+
+Coordinator::~Coordinator()
+{
+    stopWorkers();
+}
+
+CoordinatorResult Coordinator::run(const Level& level)
+{
+    // The islands travel as checkpoints, which the beam search cannot resume from
+    if (m_solverConfig.strategy == StrategyType::BEAM_SEARCH)
+    {
+        throw std::runtime_error("Coordinator::run - The beam search cannot run on islands");
+    }
+
+    CoordinatorResult result;
+
+    // Every island starts from its own seed
+    m_islands.assign(std::max<std::size_t>(1, m_config.numberOfIslands), Island());
+    for (std::size_t i = 0; i < m_islands.size(); ++i)
+    {
+        SolverConfig config = m_solverConfig;
+        config.seed = m_solverConfig.seed + i;
+
+        Solver solver(config);
+        solver.run(level);
+        m_islands[i].checkpoint = solver.checkpoint();
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point lastWorkerTime = Clock::now();
+
+    while (true)
+    {
+        loseLateWorkers(result);
+        assignIslands(level);
+
+        const bool isDone = std::all_of(m_islands.begin(), m_islands.end(), [this] (const Island& island)
+        {
+            return !island.isAssigned && isFinished(island);
+        });
+        if (isDone)
+            break;
+
+        // Without any worker, nothing moves until one connects
+        int timeout = -1;
+        if (!m_workers.empty())
+        {
+            lastWorkerTime = Clock::now();
+        }
+        else if (m_config.workerTimeout > 0.0)
+        {
+            const double remaining = m_config.workerTimeout - std::chrono::duration<double>(Clock::now() - lastWorkerTime).count();
+            if (remaining <= 0.0)
+            {
+                std::cerr << "Coordinator - No worker for " << m_config.workerTimeout << " s, giving up" << std::endl;
+                break;
+            }
+            timeout = static_cast<int>(std::ceil(remaining * 1000.0));
+        }
+
+        const int deadline = nextDeadline();
+        if (deadline >= 0 && (timeout < 0 || deadline < timeout))
+        {
+            timeout = deadline;
+        }
+
+        std::vector<pollfd> descriptors{{m_server.descriptor(), POLLIN, 0}};
+        for (const Worker& worker : m_workers)
+        {
+            descriptors.push_back({worker.socket.descriptor(), POLLIN, 0});
+        }
+        for (const Socket& socket : m_newSockets)
+        {
+            descriptors.push_back({socket.descriptor(), POLLIN, 0});
+        }
+
+        if (poll(descriptors.data(), descriptors.size(), timeout) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            throw std::runtime_error(std::string("Coordinator::run - ") + std::strerror(errno));
+        }
+
+        // Backwards, so that the lost connections can be erased
+        const std::size_t firstNewSocket = 1 + m_workers.size();
+        for (std::size_t w = m_workers.size(); w-- > 0;)
+        {
+            if (!(descriptors[w + 1].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+
+            Worker& worker = m_workers[w];
+            const auto message = receiveMessage(worker.socket);
+            if (!message || message->first != MessageType::REPORT || !worker.island)
+            {
+                loseWorker(w, result);
+                continue;
+            }
+
+            // A report which cannot be read, or not about the task of the worker,
+            // loses the task like a disconnection
+            IslandReport report;
+            try
+            {
+                report = decodeReport(message->second);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Coordinator - " << e.what() << std::endl;
+                loseWorker(w, result);
+                continue;
+            }
+
+            if (report.island != worker.island.value())
+            {
+                std::cerr << "Coordinator - Report of island " << report.island << " instead of " << worker.island.value() << std::endl;
+                loseWorker(w, result);
+                continue;
+            }
+
+            Island& island = m_islands[report.island];
+            result.numberOfEvaluations += report.checkpoint.numberOfEvaluations - island.checkpoint.numberOfEvaluations;
+            island.checkpoint = std::move(report.checkpoint);
+            island.migrants = std::move(report.migrants);
+            island.isAssigned = false;
+            island.numberOfFailures = 0;
+            worker.island.reset();
+            worker.deadline.reset();
+
+            if (report.hasLanded)
+            {
+                result.replay = std::move(report.replay);
+                result.island = report.island;
+                stopWorkers();
+                return result;
+            }
+        }
+
+        // After the workers, whose descriptors come first
+        for (std::size_t n = m_newSockets.size(); n-- > 0;)
+        {
+            if (descriptors[firstNewSocket + n].revents & (POLLIN | POLLHUP | POLLERR))
+            {
+                greetWorker(n);
+            }
+        }
+
+        if (descriptors[0].revents & POLLIN)
+        {
+            acceptWorker();
+        }
+    }
+
+    stopWorkers();
+    return result;
+}
+
+void Coordinator::acceptWorker()
+{
+    // The hello is read once the socket is readable, so that a silent
+    // connection never holds up the workers
+    Socket socket = m_server.accept();
+    socket.setReceiveTimeout(s_receiveTimeout);
+    m_newSockets.push_back(std::move(socket));
+}
+
+void Coordinator::greetWorker(std::size_t index)
+{
+    Socket socket = std::move(m_newSockets[index]);
+    m_newSockets.erase(m_newSockets.begin() + index);
+
+    const auto hello = receiveMessage(socket);
+    // The receive timeout stays, so that a worker stalled in the middle of a
+    // report is lost instead of holding up the coordinator
+    if (hello && hello->first == MessageType::HELLO && hello->second == helloPayload())
+    {
+        m_workers.push_back({std::move(socket), std::nullopt, std::nullopt});
+    }
+    else
+    {
+        std::cerr << "Coordinator - Rejected a worker speaking another protocol" << std::endl;
+    }
+}
+
+void Coordinator::loseWorker(std::size_t index, CoordinatorResult& result)
+{
+    const std::optional<std::size_t> islandIndex = m_workers[index].island;
+    m_workers.erase(m_workers.begin() + index);
+
+    if (!islandIndex)
+        return;
+
+    Island& island = m_islands[islandIndex.value()];
+    island.isAssigned = false;
+    island.numberOfFailures++;
+    result.numberOfLostTasks++;
+
+    // A task failing every time would otherwise kill every worker in turn
+    if (island.numberOfFailures >= std::max<std::size_t>(1, m_config.maxTaskFailures))
+    {
+        throw std::runtime_error("Coordinator::run - The task of island " + std::to_string(islandIndex.value()) + " failed " +
+                                 std::to_string(island.numberOfFailures) + " times in a row");
+    }
+
+    std::cerr << "Coordinator - Worker lost, island " << islandIndex.value() << " goes back to the queue" << std::endl;
+}
+
+void Coordinator::loseLateWorkers(CoordinatorResult& result)
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (std::size_t w = m_workers.size(); w-- > 0;)
+    {
+        const Worker& worker = m_workers[w];
+        if (worker.island && worker.deadline && now >= worker.deadline.value())
+        {
+            std::cerr << "Coordinator - No report of island " << worker.island.value() << " after " << m_config.taskTimeout << " s" << std::endl;
+            loseWorker(w, result);
+        }
+    }
+}
+
+int Coordinator::nextDeadline() const
+{
+    std::optional<std::chrono::steady_clock::time_point> nearest;
+    for (const Worker& worker : m_workers)
+    {
+        if (worker.deadline && (!nearest || worker.deadline.value() < nearest.value()))
+        {
+            nearest = worker.deadline;
+        }
+    }
+
+    if (!nearest)
+        return -1;
+
+    const double remaining = std::chrono::duration<double>(nearest.value() - std::chrono::steady_clock::now()).count();
+    return static_cast<int>(std::ceil(std::max(0.0, remaining) * 1000.0));
+}
+
+void Coordinator::assignIslands(const Level& level)
+{
+    for (std::size_t w = m_workers.size(); w-- > 0;)
+    {
+        Worker& worker = m_workers[w];
+        if (worker.island)
+            continue;
+
+        // The island which is the most behind goes first
+        std::optional<std::size_t> next;
+        for (std::size_t i = 0; i < m_islands.size(); ++i)
+        {
+            const Island& island = m_islands[i];
+            if (!island.isAssigned && !isFinished(island) &&
+                (!next || island.checkpoint.numberOfIterations < m_islands[next.value()].checkpoint.numberOfIterations))
+            {
+                next = i;
+            }
+        }
+
+        if (!next)
+            return;
+
+        IslandTask task;
+        task.island = static_cast<std::uint32_t>(next.value());
+        task.numberOfMigrants = m_config.numberOfMigrants;
+        task.level = level;
+        task.checkpoint = m_islands[next.value()].checkpoint;
+
+        task.generations = m_config.generationsPerTask;
+        if (m_config.maxGenerations > 0)
+        {
+            task.generations = std::min<std::uint64_t>(task.generations, m_config.maxGenerations - task.checkpoint.numberOfIterations);
+        }
+
+        // The best individuals of the previous island of the ring replace the
+        // last ones of the population
+        const Island& neighbour = m_islands[(next.value() + m_islands.size() - 1) % m_islands.size()];
+        std::vector<Phenotype>& population = task.checkpoint.population;
+        for (std::size_t i = 0; i < neighbour.migrants.size() && i < population.size() && &neighbour != &m_islands[next.value()]; ++i)
+        {
+            population[population.size() - 1 - i] = neighbour.migrants[i];
+        }
+
+        if (sendMessage(worker.socket, MessageType::TASK, encodeTask(task)))
+        {
+            worker.island = next;
+            m_islands[next.value()].isAssigned = true;
+            if (m_config.taskTimeout > 0.0)
+            {
+                worker.deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(m_config.taskTimeout));
+            }
+        }
+        else
+        {
+            m_workers.erase(m_workers.begin() + w);
+        }
+    }
+}
+
+bool Coordinator::isFinished(const Island& island) const
+{
+    return m_config.maxGenerations > 0 && island.checkpoint.numberOfIterations >= m_config.maxGenerations;
+}
+
+void Coordinator::stopWorkers()
+{
+    for (Worker& worker : m_workers)
+    {
+        sendMessage(worker.socket, MessageType::STOP, std::string());
+    }
+    m_workers.clear();
+}
+
+void runWorker(const std::string& address)
+{
+    Socket socket = Socket::connect(address);
+    if (!sendMessage(socket, MessageType::HELLO, helloPayload()))
+        return;
+
+    while (const auto message = receiveMessage(socket))
+    {
+        if (message->first != MessageType::TASK)
+            return;
+
+        const IslandTask task = decodeTask(message->second);
+
+        Solver solver(task.checkpoint.config);
+        solver.resume(task.checkpoint, task.level);
+
+        bool hasLanded = false;
+        for (std::uint64_t i = 0; i < task.generations && !hasLanded; ++i)
+        {
+            hasLanded = solver.geneticIteration();
+        }
+
+        IslandReport report;
+        report.island = task.island;
+        report.hasLanded = hasLanded;
+        report.checkpoint = solver.checkpoint();
+        report.migrants = bestIndividuals(solver.evaluatedPopulation(), task.numberOfMigrants);
+        if (hasLanded)
+        {
+            report.replay = solver.replay();
+        }
+
+        if (!sendMessage(socket, MessageType::REPORT, encodeReport(report)))
+            return;
+    }
+}
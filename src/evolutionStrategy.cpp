@@ -0,0 +1,94 @@
+#include "evolutionStrategy.hpp"
+#include "binaryStream.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+double EvolutionStrategy::s_initialStepSize = 0.3;
+
+EvolutionStrategy::EvolutionStrategy(const SolverConfig& config)
+    : SearchStrategy(config)
+    , m_numberOfParents(std::max<std::size_t>(1, config.populationSize / 4))
+{
+
+}
+
+EvolutionStrategy::~EvolutionStrategy()
+{
+
+}
+
+std::vector<Phenotype> EvolutionStrategy::initialPopulation(utils::RandomEngine& engine)
+{
+    m_parents.clear();
+    m_offspring.clear();
+
+    std::vector<Phenotype> population;
+    for (std::size_t i = 0; i < m_config.populationSize; ++i)
+    {
+        m_offspring.push_back({randomPoint(engine), s_initialStepSize, 0.0});
+        population.push_back(decode(m_offspring.back().point));
+    }
+
+    return population;
+}
+
+void EvolutionStrategy::nextPopulation(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine)
+{
+    for (std::size_t i = 0; i < m_offspring.size(); ++i)
+    {
+        m_offspring[i].score = evaluated[i].score();
+    }
+
+    // Plus selection : the parents compete with their offspring
+    m_parents.insert(m_parents.end(), std::make_move_iterator(m_offspring.begin()), std::make_move_iterator(m_offspring.end()));
+    auto hasHigherScore = [] (const Individual& a, const Individual& b) { return a.score > b.score; };
+    std::stable_sort(m_parents.begin(), m_parents.end(), hasHigherScore);
+    m_parents.resize(std::min(m_numberOfParents, m_parents.size()));
+
+    const double learningRate = 1.0 / std::sqrt(static_cast<double>(dimension()));
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    m_offspring.clear();
+    for (std::size_t i = 0; i < m_config.populationSize; ++i)
+    {
+        const Individual& parent = m_parents[utils::uniform(engine, 0, m_parents.size() - 1)];
+
+        Individual child{parent.point, parent.stepSize * std::exp(learningRate * normal(engine)), 0.0};
+        for (double& coordinate : child.point)
+        {
+            coordinate = std::clamp(coordinate + child.stepSize * normal(engine), -1.0, 1.0);
+        }
+
+        next.push_back(decode(child.point));
+        m_offspring.push_back(std::move(child));
+    }
+}
+
+void EvolutionStrategy::saveState(std::ostream& stream) const
+{
+    for (const std::vector<Individual>* individuals : {&m_parents, &m_offspring})
+    {
+        utils::writeBinary<std::uint64_t>(stream, individuals->size());
+        for (const Individual& individual : *individuals)
+        {
+            utils::writeBinaryVector(stream, individual.point);
+            utils::writeBinary(stream, individual.stepSize);
+            utils::writeBinary(stream, individual.score);
+        }
+    }
+}
+
+void EvolutionStrategy::loadState(std::istream& stream)
+{
+    for (std::vector<Individual>* individuals : {&m_parents, &m_offspring})
+    {
+        individuals->resize(utils::readBinary<std::uint64_t>(stream));
+        for (Individual& individual : *individuals)
+        {
+            individual.point = utils::readBinaryVector<double>(stream);
+            individual.stepSize = utils::readBinary<double>(stream);
+            individual.score = utils::readBinary<double>(stream);
+        }
+    }
+}
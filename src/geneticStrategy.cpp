@@ -0,0 +1,210 @@
+#include "geneticStrategy.hpp"
+#include "binaryStream.hpp"
+
+#include <algorithm>
+
+GeneticStrategy::GeneticStrategy(const SolverConfig& config)
+    : SearchStrategy(config)
+    , m_selector(config.selection)
+    , m_niching(config.niching)
+{
+
+}
+
+GeneticStrategy::~GeneticStrategy()
+{
+
+}
+
+std::vector<Phenotype> GeneticStrategy::initialPopulation(utils::RandomEngine& engine)
+{
+    std::vector<Phenotype> population;
+    population.reserve(m_config.populationSize);
+
+    for (std::size_t i = 0; i < m_config.populationSize; ++i)
+    {
+        population.emplace_back(m_config.encoding.numberOfGenes(m_config.geneLength), engine);
+    }
+
+    return population;
+}
+
+void GeneticStrategy::nextPopulation(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine)
+{
+    if (m_config.niching.method == NichingMethod::CROWDING)
+    {
+        breedCrowded(evaluated, next, engine);
+        return;
+    }
+
+    if (m_config.niching.method == NichingMethod::SHARING)
+    {
+        m_selector.prepare(m_niching.sharedScores(evaluated, engine));
+    }
+    else
+    {
+        m_selector.prepare(evaluated);
+    }
+
+    for (std::size_t k = 0; k < evaluated.size(); ++k)
+    {
+        Phenotype newPhenotype({}, 0.0);
+        const double crossoverProbability = utils::uniform(engine, 0., 1.);
+        if (crossoverProbability < m_config.crossoverRate)
+        {
+            const Phenotype& parent1 = evaluated[m_selector.select(engine)];
+            const Phenotype& parent2 = evaluated[m_selector.select(engine)];
+
+            newPhenotype = arithmeticCrossover(parent1, parent2, engine);
+        }
+        else
+        {
+            newPhenotype = evaluated[m_selector.select(engine)];
+        }
+
+        mutate(newPhenotype, engine);
+        next.push_back(std::move(newPhenotype));
+    }
+}
+
+void GeneticStrategy::saveState(std::ostream& stream) const
+{
+    utils::writeBinary<std::uint64_t>(stream, m_parents.size());
+    for (const Phenotype& parent : m_parents)
+    {
+        utils::writeBinaryVector(stream, parent.genes());
+        utils::writeBinary(stream, parent.score());
+    }
+}
+
+void GeneticStrategy::loadState(std::istream& stream)
+{
+    m_parents.clear();
+
+    const std::uint64_t size = utils::readBinary<std::uint64_t>(stream);
+    for (std::uint64_t i = 0; i < size && stream; ++i)
+    {
+        std::vector<Gene> genes = utils::readBinaryVector<Gene>(stream);
+        const double score = utils::readBinary<double>(stream);
+        m_parents.emplace_back(std::move(genes), score);
+    }
+}
+
+void GeneticStrategy::breedCrowded(const std::vector<Phenotype>& evaluated, std::vector<Phenotype>& next, utils::RandomEngine& engine)
+{
+    // Children 2p and 2p + 1 were bred from parents 2p and 2p + 1. Each child is
+    // matched with the closest parent, and replaces it when it scores as well.
+    // The first generation, or one whose size changed, has no parents to beat.
+    std::vector<Phenotype> survivors;
+    if (m_parents.size() != evaluated.size())
+    {
+        survivors = evaluated;
+    }
+    else
+    {
+        survivors = std::move(m_parents);
+        for (std::size_t p = 0; p + 1 < evaluated.size(); p += 2)
+        {
+            const Phenotype& child1 = evaluated[p];
+            const Phenotype& child2 = evaluated[p + 1];
+            const double straight = Niching::distance(survivors[p], child1) + Niching::distance(survivors[p + 1], child2);
+            const double crossed = Niching::distance(survivors[p], child2) + Niching::distance(survivors[p + 1], child1);
+
+            const std::size_t first = straight <= crossed ? p : p + 1;
+            const std::size_t second = straight <= crossed ? p + 1 : p;
+            if (child1.score() >= survivors[first].score())
+                survivors[first] = child1;
+            if (child2.score() >= survivors[second].score())
+                survivors[second] = child2;
+        }
+
+        if (evaluated.size() % 2 == 1 && evaluated.back().score() >= survivors.back().score())
+        {
+            survivors.back() = evaluated.back();
+        }
+    }
+
+    for (std::size_t i = survivors.size(); i > 1; --i)
+    {
+        std::swap(survivors[i - 1], survivors[utils::uniform(engine, 0, static_cast<int>(i) - 1)]);
+    }
+
+    for (std::size_t p = 0; p < survivors.size(); p += 2)
+    {
+        const Phenotype& parent1 = survivors[p];
+        const Phenotype& parent2 = survivors[std::min(p + 1, survivors.size() - 1)];
+
+        Phenotype child1 = parent1;
+        Phenotype child2 = parent2;
+        if (utils::uniform(engine, 0., 1.) < m_config.crossoverRate)
+        {
+            child1 = arithmeticCrossover(parent1, parent2, engine);
+            child2 = arithmeticCrossover(parent2, parent1, engine);
+        }
+
+        mutate(child1, engine);
+        next.push_back(std::move(child1));
+        if (next.size() < survivors.size())
+        {
+            mutate(child2, engine);
+            next.push_back(std::move(child2));
+        }
+    }
+
+    m_parents = std::move(survivors);
+}
+
+Phenotype GeneticStrategy::arithmeticCrossover(const Phenotype& parent1, const Phenotype& parent2, utils::RandomEngine& engine)
+{
+    // Variable-length genomes only blend the genes both parents have, and an
+    // empty one, such as an empty warm start, has none to blend
+    const std::size_t commonSize = std::min(parent1.size(), parent2.size());
+    if (commonSize == 0)
+        return parent1;
+
+    Phenotype child = parent1;
+    const int leftIdx = utils::uniform(engine, 0, commonSize - 1);
+    const int rightIdx = utils::uniform(engine, leftIdx, commonSize - 1);
+
+    // The blending weight is expressed in 1/256th so that the loop only runs
+    // on small integers over the packed genes
+    const int alpha = utils::uniform(engine, 0, 256);
+    auto blend = [alpha] (std::int8_t a, std::int8_t b)
+    {
+        return static_cast<std::int8_t>((alpha * a + (256 - alpha) * b + 128) >> 8);
+    };
+
+    Gene* childGenes = child.genes().data();
+    const Gene* otherGenes = parent2.genes().data();
+    for (int i = leftIdx; i <= rightIdx; ++i)
+    {
+        childGenes[i].thrust = blend(childGenes[i].thrust, otherGenes[i].thrust);
+        childGenes[i].angle = blend(childGenes[i].angle, otherGenes[i].angle);
+    }
+
+    return child;
+}
+
+void GeneticStrategy::mutate(Phenotype& phenotype, utils::RandomEngine& engine)
+{
+    for (Gene& gene : phenotype.genes())
+    {
+        const double probability = utils::uniform(engine, 0., 1.);
+        if (probability < m_config.mutationRate)
+        {
+            gene.angle = static_cast<std::int8_t>(utils::uniform(engine, -90, 90));
+            gene.thrust = static_cast<std::int8_t>(utils::uniform(engine, -1, 1));
+        }
+    }
+
+    // Trimmed genomes can grow back, up to the maximum flight duration
+    const ControlEncoding& encoding = m_config.encoding;
+    if (encoding.isVariableLength() && phenotype.size() * encoding.stepsPerGene < encoding.maxSteps)
+    {
+        if (utils::uniform(engine, 0., 1.) < m_config.mutationRate)
+        {
+            phenotype.genes().push_back({static_cast<std::int8_t>(utils::uniform(engine, -90, 90)),
+                                         static_cast<std::int8_t>(utils::uniform(engine, -1, 1))});
+        }
+    }
+}
@@ -1,88 +1,64 @@
 #include "lander.hpp"
-#include "utils.hpp"
+#include "fixedPoint.hpp"
 
-#include <SFML/Graphics/RenderTarget.hpp>
-
-#include <math.h>
-#include <algorithm>
-
-double Lander::s_gravity = 3.711; 
-
-Lander::Lander(const Point2d& position, const Point2d& velocity, int fuel, int angle, int thrust)
-    : m_shape{3}
-    , m_position{position}
-    , m_previousPosition{position}
-    , m_velocity{velocity}
-    , m_acceleration{thrust * std::sin(utils::toRadian(-angle)),
-                     thrust * std::cos(utils::toRadian(-angle)) - s_gravity}
-    , m_fuel{fuel}
-    , m_angle{angle}
-    , m_thrust{thrust}
-{
-    m_shape.setPoint(0, sf::Vector2f(0, 0));
-    m_shape.setPoint(1, sf::Vector2f(50, 100));
-    m_shape.setPoint(2, sf::Vector2f(100, 0));
-    m_shape.setFillColor(sf::Color::Green);
-    utils::centerOrigin(m_shape);
-    this->setPosition(position.x, position.y);
-}
-
-Lander::~Lander()
-{
-
-}
-
-void Lander::draw(sf::RenderTarget& target, sf::RenderStates states) const
-{
-    sf::Transform transform = states.transform;
-    transform *= getTransform();
-
-    target.draw(m_shape, utils::scaledScreenTransform() * transform);
-}
-
-void Lander::simulationStep(int angle, int thrust)
-{
-    m_previousPosition = m_position;
-
-    int clampedAngle = std::clamp(m_angle + angle, m_angle - 15, m_angle + 15);
-    int clampedThrust = std::clamp(m_thrust + thrust, m_thrust - 1, m_thrust + 1);
-
-    m_angle = std::clamp(clampedAngle, -90, 90);
-    m_thrust = std::clamp(clampedThrust, 0, 4);
-    m_fuel -= thrust;
-
-    m_acceleration.x = m_thrust * std::sin(utils::toRadian(-m_angle));
-    m_acceleration.y = m_thrust * std::cos(utils::toRadian(-m_angle)) - s_gravity;
-    
-    m_velocity.x += m_acceleration.x;
-    m_velocity.y += m_acceleration.y;
-
-    m_position.x += m_velocity.x + (0.5 * m_acceleration.x);
-    m_position.y += m_velocity.y + (0.5 * m_acceleration.y);
-}
-
-const Polyline Lander::trajectoryLine() const
-{
-    Polyline trajectoryLine;
-    trajectoryLine.push_back(m_previousPosition);
-    trajectoryLine.push_back(m_position);
-
-    return trajectoryLine;
-}
-
-bool Lander::hasSafelyLanded() const noexcept
-{
-    return (std::abs(m_angle)      <= 15 &&
-            std::abs(m_velocity.x) <= 20 &&
-            std::abs(m_velocity.y) <= 40);
-}
-
-const Point2d& Lander::position() const noexcept
-{
-    return m_position;
-}
-
-const Point2d& Lander::velocity() const noexcept
+// Compile-time checks of the physics kernel. A change of the model which moves
+// these trajectories breaks the build, as it would silently invalidate the saved
+// replays and checkpoints.
+namespace
 {
-    return m_velocity;
+    // Start of the first level, thrust raised to the maximum, a short turn to
+    // the left and back, then a climb with the engine at full power
+    template <typename T>
+    constexpr BasicLander<T> referenceFlight()
+    {
+        BasicLander<T> lander({T(2500), T(2700)}, {T(0), T(0)}, 550, 0, 0);
+        for (int i = 0; i < 60; ++i)
+        {
+            lander.simulationStep(i < 2 ? 15 : (i < 4 ? -15 : 0), 1);
+        }
+
+        return lander;
+    }
+
+    // Engine off : the closed form of a free fall, up to rounding. The speed is
+    // updated before the position, which gives y0 - g n (n + 2) / 2
+    template <typename T>
+    constexpr bool isFreeFall(int steps, T tolerance)
+    {
+        BasicLander<T> lander({T(2500), T(2700)}, {T(0), T(0)}, 0, 0, 0);
+        for (int i = 0; i < steps; ++i)
+        {
+            lander.simulationStep(0, 0);
+        }
+
+        const T expected = T(2700) - BasicLander<T>::s_gravity * T(steps) * T(steps + 2) / T(2);
+        return scalar::abs(lander.position().y - expected) < tolerance && lander.position().x == T(2500);
+    }
+
+    // Fixed-point flights are bit-exact on every platform
+    constexpr BasicLander<Fixed> s_fixedFlight = referenceFlight<Fixed>();
+    static_assert(s_fixedFlight.position().x.raw() == 155937576 && s_fixedFlight.position().y.raw() == 187076367,
+                  "The fixed-point reference trajectory has moved");
+    static_assert(s_fixedFlight.velocity().x.raw() == -133384 && s_fixedFlight.velocity().y.raw() == 716692,
+                  "The fixed-point reference velocity has moved");
+    static_assert(s_fixedFlight.fuel() == 316 && s_fixedFlight.angle() == 0, "The fuel or angle of the reference flight has moved");
+    static_assert(s_fixedFlight.hasSafelyLanded() && s_fixedFlight.canStillLand(), "The landing checks of the reference flight have moved");
+
+    // The floating point flights follow the fixed-point one closely
+    constexpr BasicLander<double> s_doubleFlight = referenceFlight<double>();
+    static_assert(scalar::abs(s_doubleFlight.position().x - scalar::toDouble(s_fixedFlight.position().x)) < 0.01 &&
+                  scalar::abs(s_doubleFlight.position().y - scalar::toDouble(s_fixedFlight.position().y)) < 0.01,
+                  "The double reference trajectory has moved away from the fixed-point one");
+
+    static_assert(isFreeFall<double>(40, 1e-6) && isFreeFall<float>(40, 0.01f), "A free fall no longer follows the gravity");
+
+    // Out of fuel and falling too fast, the outcome is known
+    constexpr bool isHopeless()
+    {
+        BasicLander<double> lander({2500.0, 2700.0}, {0.0, -45.0}, 0, 0, 0);
+        lander.simulationStep(0, 0);
+        return !lander.canStillLand() && !lander.hasSafelyLanded();
+    }
+
+    static_assert(isHopeless(), "The landing checks have moved");
 }
@@ -0,0 +1,27 @@
+#include "landerShape.hpp"
+#include "utils.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+LanderShape::LanderShape()
+    : m_shape{3}
+{
+    m_shape.setPoint(0, sf::Vector2f(0, 0));
+    m_shape.setPoint(1, sf::Vector2f(50, 100));
+    m_shape.setPoint(2, sf::Vector2f(100, 0));
+    m_shape.setFillColor(sf::Color::Green);
+    utils::centerOrigin(m_shape);
+}
+
+LanderShape::~LanderShape()
+{
+
+}
+
+void LanderShape::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    sf::Transform transform = states.transform;
+    transform *= getTransform();
+
+    target.draw(m_shape, utils::scaledScreenTransform() * transform);
+}
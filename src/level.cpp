@@ -0,0 +1,160 @@
+#include "level.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    // 64-bit FNV-1a
+    class Hasher
+    {
+    public:
+        template <typename T>
+        void add(const T& value)
+        {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                m_hash ^= bytes[i];
+                m_hash *= 1099511628211ull;
+            }
+        }
+
+        std::uint64_t hash() const noexcept
+        {
+            return m_hash;
+        }
+
+    private:
+        std::uint64_t m_hash{14695981039346656037ull};
+    };
+
+    std::vector<std::string> splitText(const std::string& text)
+    {
+        std::istringstream iss{text};
+        std::vector<std::string> result(std::istream_iterator<std::string>{iss},
+                                        std::istream_iterator<std::string>());
+
+        return result;
+    }
+}
+
+Level loadLevel(const std::string& fileName)
+{
+    std::ifstream file(fileName);
+    std::string buffer;
+
+    if (!file)
+    {
+       throw std::runtime_error("loadLevel - Failed to load " + fileName);
+    }
+
+    Level level;
+
+    // retrieve lander initial data
+    std::getline(file, buffer);
+    std::vector<std::string> values = splitText(buffer);
+    level.data.position = {std::stof(values[0]), std::stof(values[1])};
+    level.data.velocity = {std::stof(values[2]), std::stof(values[3])};
+    level.data.fuel = std::stoi(values[4]);
+    level.data.angle = std::stoi(values[5]);
+    level.data.thrust = std::stoi(values[6]);
+
+    // retrieve surface points
+    while (std::getline(file, buffer))
+    {
+        values = splitText(buffer);
+        level.surfacePoints.push_back({std::stof(values[0]), std::stof(values[1])});
+    }
+
+    return level;
+}
+
+Level generateLevel(std::uint64_t seed)
+{
+    utils::RandomEngine engine(static_cast<utils::RandomEngine::result_type>(seed));
+    Level level;
+
+    const int landingWidth = utils::uniform(engine, 1000, 2000);
+    const int landingLeft = utils::uniform(engine, 0, 6999 - landingWidth);
+    const int landingRight = landingLeft + landingWidth;
+    const int landingHeight = utils::uniform(engine, 100, 1500);
+
+    // Rough ground on both sides of the landing area, never flat
+    auto addRoughGround = [&engine, &level] (int from, int to)
+    {
+        int x = from;
+        while (to - x > 200)
+        {
+            x = std::min(to - 100, x + utils::uniform(engine, 200, 1000));
+            double y = utils::uniform(engine, 100, 2200);
+            if (y == level.surfacePoints.back().y)
+                y += 50.0;
+            level.surfacePoints.push_back({static_cast<double>(x), y});
+        }
+    };
+
+    level.surfacePoints.push_back({0.0, landingLeft == 0 ? landingHeight : static_cast<double>(utils::uniform(engine, 100, 2200))});
+    if (landingLeft > 0)
+    {
+        addRoughGround(0, landingLeft);
+        if (level.surfacePoints.back().y == landingHeight)
+            level.surfacePoints.back().y += 50.0;
+        level.surfacePoints.push_back({static_cast<double>(landingLeft), static_cast<double>(landingHeight)});
+    }
+    level.surfacePoints.push_back({static_cast<double>(landingRight), static_cast<double>(landingHeight)});
+    if (landingRight < 6999)
+    {
+        addRoughGround(landingRight, 6999);
+        const double y = utils::uniform(engine, 100, 2200);
+        level.surfacePoints.push_back({6999.0, y == level.surfacePoints.back().y ? y + 50.0 : y});
+    }
+
+    // The lander starts far enough from the landing area to need some steering,
+    // and above every point of the ground
+    const double highestGround = std::max_element(level.surfacePoints.begin(), level.surfacePoints.end(),
+                                                  [] (const Point2d& a, const Point2d& b) { return a.y < b.y; })->y;
+    level.data.position = {static_cast<double>(utils::uniform(engine, 500, 6500)),
+                           static_cast<double>(utils::uniform(engine, static_cast<int>(highestGround) + 300, 2900))};
+    level.data.velocity = {static_cast<double>(utils::uniform(engine, -50, 50)), 0.0};
+    level.data.fuel = utils::uniform(engine, 600, 1200);
+
+    return level;
+}
+
+Polyline findLandingLine(const Polyline& surfacePoints)
+{
+    auto hasSameYCoordinate = [] (const Point2d& p, const Point2d& q) { return p.y == q.y; };
+    auto iter = std::adjacent_find(surfacePoints.begin(), surfacePoints.end(), hasSameYCoordinate);
+    if (iter == surfacePoints.end())
+    {
+        throw std::runtime_error("findLandingLine - The surface has no flat area to land on");
+    }
+
+    return {*iter, *std::next(iter)};
+}
+
+std::uint64_t levelHash(const Level& level)
+{
+    Hasher hasher;
+    hasher.add(level.data.position.x);
+    hasher.add(level.data.position.y);
+    hasher.add(level.data.velocity.x);
+    hasher.add(level.data.velocity.y);
+    hasher.add(level.data.fuel);
+    hasher.add(level.data.angle);
+    hasher.add(level.data.thrust);
+
+    for (const Point2d& point : level.surfacePoints)
+    {
+        hasher.add(point.x);
+        hasher.add(point.y);
+    }
+
+    return hasher.hash();
+}
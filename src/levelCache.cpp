@@ -0,0 +1,276 @@
+#include "levelCache.hpp"
+#include "binaryStream.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    const char s_magic[4] = {'M', 'L', 'P', 'L'};
+    const std::uint32_t s_version = 3;
+}
+
+LevelCache::LevelCache(const std::string& directory, std::size_t capacity)
+    : m_directory(directory)
+    , m_capacity(std::max<std::size_t>(1, capacity))
+    , m_numberOfHits(0)
+    , m_numberOfMisses(0)
+{
+
+}
+
+LevelCache::~LevelCache()
+{
+
+}
+
+std::shared_ptr<const PreparedLevel> LevelCache::prepare(const Level& level)
+{
+    const std::uint64_t hash = levelHash(level);
+    if (std::shared_ptr<const PreparedLevel> preparedLevel = find(hash))
+        return preparedLevel;
+
+    return build(level, hash);
+}
+
+std::shared_ptr<const PreparedLevel> LevelCache::load(const std::string& fileName)
+{
+    const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(fileName);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto file = m_files.find(fileName);
+        if (file != m_files.end() && file->second.lastWriteTime == lastWriteTime)
+        {
+            auto level = m_levels.find(file->second.hash);
+            if (level != m_levels.end())
+            {
+                m_numberOfHits++;
+                touch(level->first);
+                return level->second.level;
+            }
+        }
+    }
+
+    std::shared_ptr<const PreparedLevel> preparedLevel = prepare(loadLevel(fileName));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files[fileName] = {lastWriteTime, preparedLevel->hash};
+
+    return preparedLevel;
+}
+
+void LevelCache::setDirectory(const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directory = directory;
+}
+
+void LevelCache::setCapacity(std::size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = std::max<std::size_t>(1, capacity);
+    evict();
+}
+
+void LevelCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_levels.clear();
+    m_recentUses.clear();
+    m_files.clear();
+    m_numberOfHits = 0;
+    m_numberOfMisses = 0;
+}
+
+std::size_t LevelCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_levels.size();
+}
+
+std::size_t LevelCache::numberOfHits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numberOfHits;
+}
+
+std::size_t LevelCache::numberOfMisses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numberOfMisses;
+}
+
+std::shared_ptr<const PreparedLevel> LevelCache::find(std::uint64_t hash)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto level = m_levels.find(hash);
+    if (level == m_levels.end())
+        return nullptr;
+
+    m_numberOfHits++;
+    touch(hash);
+    return level->second.level;
+}
+
+std::shared_ptr<const PreparedLevel> LevelCache::build(const Level& level, std::uint64_t hash)
+{
+    const std::string fileName = cacheFileName(hash);
+    std::shared_ptr<PreparedLevel> preparedLevel;
+
+    if (!fileName.empty() && std::filesystem::exists(fileName))
+    {
+        try
+        {
+            preparedLevel = std::make_shared<PreparedLevel>(loadPreparedLevel(fileName));
+            if (preparedLevel->hash != hash)
+                preparedLevel.reset();
+        }
+        catch (const std::exception& e)
+        {
+            // A damaged cache file is simply rebuilt
+            std::cerr << "LevelCache - " << e.what() << std::endl;
+        }
+    }
+
+    if (!preparedLevel)
+    {
+        preparedLevel = std::make_shared<PreparedLevel>(PreparedLevel{hash, level, Terrain(level.surfacePoints)});
+
+        try
+        {
+            if (!fileName.empty())
+                savePreparedLevel(*preparedLevel, fileName);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "LevelCache - " << e.what() << std::endl;
+        }
+    }
+
+    // Another thread may have prepared the same level meanwhile, the first one is kept
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_numberOfMisses++;
+
+    auto cached = m_levels.find(hash);
+    if (cached != m_levels.end())
+    {
+        touch(hash);
+        return cached->second.level;
+    }
+
+    m_recentUses.push_front(hash);
+    m_levels.emplace(hash, CachedLevel{preparedLevel, m_recentUses.begin()});
+    evict();
+
+    return preparedLevel;
+}
+
+void LevelCache::touch(std::uint64_t hash)
+{
+    m_recentUses.splice(m_recentUses.begin(), m_recentUses, m_levels.at(hash).recentUse);
+}
+
+void LevelCache::evict()
+{
+    while (m_levels.size() > m_capacity)
+    {
+        m_levels.erase(m_recentUses.back());
+        m_recentUses.pop_back();
+    }
+}
+
+std::string LevelCache::cacheFileName(std::uint64_t hash) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_directory.empty())
+        return {};
+
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash << ".level";
+
+    return (std::filesystem::path(m_directory) / stream.str()).string();
+}
+
+LevelCache& levelCache()
+{
+    static LevelCache cache;
+    return cache;
+}
+
+void savePreparedLevel(const PreparedLevel& preparedLevel, const std::string& fileName)
+{
+    // Write next to the destination then rename, so that concurrent processes
+    // never read a partial file
+    const std::string temporaryFileName = fileName + ".tmp";
+
+    {
+        std::ofstream file(temporaryFileName, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            throw std::runtime_error("savePreparedLevel - Failed to open " + temporaryFileName);
+        }
+
+        const LevelData& data = preparedLevel.level.data;
+        file.write(s_magic, sizeof(s_magic));
+        utils::writeBinary(file, s_version);
+        utils::writeBinary(file, preparedLevel.hash);
+        utils::writeBinary(file, data.position);
+        utils::writeBinary(file, data.velocity);
+        utils::writeBinary<std::int32_t>(file, data.fuel);
+        utils::writeBinary<std::int32_t>(file, data.angle);
+        utils::writeBinary<std::int32_t>(file, data.thrust);
+        preparedLevel.terrain.save(file);
+
+        if (!file)
+        {
+            throw std::runtime_error("savePreparedLevel - Failed to write " + temporaryFileName);
+        }
+    }
+
+    if (std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+    {
+        std::remove(fileName.c_str());
+        if (std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+        {
+            throw std::runtime_error("savePreparedLevel - Failed to replace " + fileName);
+        }
+    }
+}
+
+PreparedLevel loadPreparedLevel(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("loadPreparedLevel - Failed to load " + fileName);
+    }
+
+    char magic[4];
+    file.read(magic, sizeof(magic));
+    if (!file || !std::equal(magic, magic + 4, s_magic) || utils::readBinary<std::uint32_t>(file) != s_version)
+    {
+        throw std::runtime_error("loadPreparedLevel - " + fileName + " is not a prepared level of this version");
+    }
+
+    PreparedLevel preparedLevel;
+    preparedLevel.hash = utils::readBinary<std::uint64_t>(file);
+
+    LevelData& data = preparedLevel.level.data;
+    data.position = utils::readBinary<Point2d>(file);
+    data.velocity = utils::readBinary<Point2d>(file);
+    data.fuel = utils::readBinary<std::int32_t>(file);
+    data.angle = utils::readBinary<std::int32_t>(file);
+    data.thrust = utils::readBinary<std::int32_t>(file);
+
+    preparedLevel.terrain = Terrain::load(file);
+    preparedLevel.level.surfacePoints = preparedLevel.terrain.surfacePoints();
+
+    return preparedLevel;
+}
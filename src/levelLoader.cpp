@@ -1,14 +1,9 @@
 #include "levelLoader.hpp"
 #include "utils.hpp"
 
-#include <iterator>
-#include <fstream>
-#include <sstream>
-
 LevelLoader::LevelLoader() :
-    m_levelData(),
-    m_groundLines(sf::LineStrip),
-    m_surfacePoints()
+    m_preparedLevel(std::make_shared<PreparedLevel>()),
+    m_groundLines(sf::LineStrip)
 {
 
 }
@@ -20,58 +15,38 @@ LevelLoader::~LevelLoader()
 
 void LevelLoader::load(const std::string& levelName)
 {
-    m_surfacePoints.clear();
-    m_groundLines.clear();
-
-    std::ifstream file(levelName);
-    std::string buffer;
-
-    if (!file)
-    {
-       throw std::runtime_error("LevelLoader::load - Failed to load " + levelName);
-    }
+    // Levels already loaded are neither parsed nor preprocessed again
+    setLevel(levelCache().load(levelName));
+}
 
-    // retrieve lander initial data
-    std::getline(file, buffer);
-    std::vector<std::string> values = splitText(buffer);
-    m_levelData.position = {std::stof(values[0]), std::stof(values[1])};
-    m_levelData.velocity = {std::stof(values[2]), std::stof(values[3])};
-    m_levelData.fuel = std::stoi(values[4]);
-    m_levelData.angle = std::stoi(values[5]);
-    m_levelData.thrust = std::stoi(values[6]);
+void LevelLoader::setLevel(std::shared_ptr<const PreparedLevel> level)
+{
+    m_groundLines.clear();
+    m_preparedLevel = std::move(level);
 
-    // retrieve surface points
-    while (std::getline(file, buffer))
+    for (const Point2d& p : m_preparedLevel->level.surfacePoints)
     {
-        values = splitText(buffer);
-
-        sf::Vector2f p(std::stof(values[0]), std::stof(values[1]));
-        sf::Vertex v({p.x, p.y}, sf::Color::Red);
+        sf::Vertex v(sf::Vector2f(p.x, p.y), sf::Color::Red);
         m_groundLines.append(v);
-        m_surfacePoints.push_back({p.x, p.y});
     }
 }
 
-void LevelLoader::render(sf::RenderWindow& window)
+void LevelLoader::render(sf::RenderTarget& target)
 {
-    window.draw(m_groundLines, utils::scaledScreenTransform());
+    target.draw(m_groundLines, utils::scaledScreenTransform());
 }
 
 const Polyline& LevelLoader::surfacePoints() noexcept
 {
-    return m_surfacePoints;
+    return m_preparedLevel->level.surfacePoints;
 }
 
 const LevelData& LevelLoader::levelData() noexcept
 {
-    return m_levelData;
+    return m_preparedLevel->level.data;
 }
 
-const std::vector<std::string> LevelLoader::splitText(const std::string& text)
+std::shared_ptr<const PreparedLevel> LevelLoader::preparedLevel() const noexcept
 {
-    std::istringstream iss{text};
-    std::vector<std::string> result(std::istream_iterator<std::string>{iss},
-                                    std::istream_iterator<std::string>());
-
-    return result;
+    return m_preparedLevel;
 }
@@ -0,0 +1,145 @@
+#include "localSearch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    // Deltas tried for each gene : the lander clamps the angle delta to
+    // [-15, 15] and the thrust delta to [-1, 1]
+    const std::int8_t s_angles[] = {-15, -5, 0, 5, 15};
+    const std::int8_t s_thrusts[] = {-1, 0, 1};
+}
+
+LocalSearch::LocalSearch(const LocalSearchConfig& config, const ControlEncoding& encoding)
+    : m_config(config)
+    , m_encoding(encoding)
+{
+
+}
+
+LocalSearch::~LocalSearch()
+{
+
+}
+
+LocalSearchResult LocalSearch::refine(Phenotype& phenotype, const Lander& lander, const Terrain& terrain) const
+{
+    LocalSearchResult searchResult;
+
+    RolloutResult<double> best = rollout(lander, phenotype, terrain, m_encoding, [] (const Point2d&) {});
+    searchResult.evaluations++;
+
+    if (best.hasLanded)
+    {
+        searchResult.landingSteps = best.steps;
+        return searchResult;
+    }
+
+    if (!isOnLandingArea(best, terrain) || best.steps == 0)
+        return searchResult;
+
+    // Genes flown during the last steps before the impact
+    const std::size_t lastGene = std::min(phenotype.size(), m_encoding.numberOfGenes(best.steps));
+    const std::size_t firstGene = lastGene - std::min(lastGene, m_config.tailGenes);
+    const std::size_t firstStep = firstGene * m_encoding.stepsPerGene;
+
+    // The genes before the tail never change
+    Lander tailStart = lander;
+    for (std::size_t step = 0; step < firstStep; ++step)
+    {
+        const Gene gene = geneAtStep(phenotype, m_encoding, step);
+        tailStart.simulationStep(gene.angle, gene.thrust);
+    }
+
+    double bestError = landingError(best, terrain);
+    bool hasImproved = true;
+    std::vector<Lander> geneStarts(lastGene - firstGene, tailStart);
+
+    while (hasImproved && searchResult.evaluations < m_config.evaluations)
+    {
+        hasImproved = false;
+
+        // State of the lander when each gene of the tail starts. A gene only
+        // changes the states after it, and the genes are searched backwards :
+        // they stay valid for the whole pass.
+        for (std::size_t id = firstGene + 1; id < lastGene; ++id)
+        {
+            geneStarts[id - firstGene] = geneStarts[id - firstGene - 1];
+            for (std::size_t step = (id - 1) * m_encoding.stepsPerGene; step < id * m_encoding.stepsPerGene; ++step)
+            {
+                const Gene gene = geneAtStep(phenotype, m_encoding, step);
+                geneStarts[id - firstGene].simulationStep(gene.angle, gene.thrust);
+            }
+        }
+
+        // From the touchdown backwards : the last genes have the most direct
+        // effect on the touchdown speed and angle
+        for (std::size_t id = lastGene; id-- > firstGene && searchResult.evaluations < m_config.evaluations;)
+        {
+            Gene& gene = phenotype.gene(id);
+            const Gene original = gene;
+            Gene bestGene = original;
+
+            for (std::int8_t angle : s_angles)
+            {
+                for (std::int8_t thrust : s_thrusts)
+                {
+                    if ((angle == original.angle && thrust == original.thrust) || searchResult.evaluations >= m_config.evaluations)
+                        continue;
+
+                    gene = Gene{angle, thrust};
+                    const RolloutResult<double> trial = rolloutFrom(geneStarts[id - firstGene], id * m_encoding.stepsPerGene,
+                                                                    phenotype, terrain, m_encoding, [] (const Point2d&) {});
+                    searchResult.evaluations++;
+
+                    if (trial.hasLanded)
+                    {
+                        phenotype.computeScore(trial.lander, terrain);
+                        searchResult.landingSteps = trial.steps;
+                        return searchResult;
+                    }
+
+                    const double error = landingError(trial, terrain);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestGene = gene;
+                        best = trial;
+                    }
+                }
+            }
+
+            gene = bestGene;
+            hasImproved = hasImproved || bestGene.angle != original.angle || bestGene.thrust != original.thrust;
+        }
+    }
+
+    phenotype.computeScore(best.lander, terrain);
+
+    return searchResult;
+}
+
+double LocalSearch::landingError(const RolloutResult<double>& result, const Terrain& terrain) const
+{
+    if (!isOnLandingArea(result, terrain))
+    {
+        // Always worse than a touchdown on the landing area
+        Phenotype scored(0);
+        scored.computeScore(result.lander, terrain);
+        return 1000.0 - scored.score();
+    }
+
+    // Margins by which the touchdown misses a safe landing
+    const Point2d& velocity = result.lander.velocity();
+    return std::max(0.0, std::abs(velocity.x) - 20.0) +
+           std::max(0.0, std::abs(velocity.y) - 40.0) +
+           std::max(0, std::abs(result.lander.angle()) - 15);
+}
+
+bool LocalSearch::isOnLandingArea(const RolloutResult<double>& result, const Terrain& terrain) const
+{
+    const Polyline& landingLine = terrain.landingLine();
+    return result.impact && result.impact->x >= landingLine[0].x && result.impact->x <= landingLine[1].x;
+}
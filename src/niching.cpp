@@ -0,0 +1,268 @@
+#include "niching.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    // A thrust delta of 1 weighs as an angle delta of 15 degrees
+    const int s_thrustWeight = 15;
+    const int s_keyOffset = 128;
+
+    std::uint8_t angleKey(const Gene& gene)
+    {
+        return static_cast<std::uint8_t>(gene.angle + s_keyOffset);
+    }
+
+    std::uint8_t thrustKey(const Gene& gene)
+    {
+        return static_cast<std::uint8_t>(gene.thrust * s_thrustWeight + s_keyOffset);
+    }
+
+    // Written on unsigned bytes with a plain accumulator, so that it is
+    // vectorized as a sum of absolute differences
+    std::uint32_t sumOfAbsoluteDifferences(const std::uint8_t* a, const std::uint8_t* b, std::size_t size)
+    {
+        std::uint32_t sum = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            sum += static_cast<std::uint32_t>(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+        }
+
+        return sum;
+    }
+}
+
+Niching::Niching(const NichingConfig& config)
+    : m_config(config)
+    , m_stride(0)
+    , m_size(0)
+    , m_radius(0.0)
+{
+    // The approximations divide by the number of samples
+    m_config.samples = std::max<std::size_t>(1, m_config.samples);
+}
+
+Niching::~Niching()
+{
+
+}
+
+const std::vector<double>& Niching::sharedScores(const std::vector<Phenotype>& population, utils::RandomEngine& engine)
+{
+    pack(population);
+
+    m_nicheSizes.assign(m_size, 1.0);
+    if (m_config.approximation == NichingApproximation::EXACT || m_size <= m_config.samples + 1)
+    {
+        countExactly();
+    }
+    else if (m_config.approximation == NichingApproximation::SAMPLING)
+    {
+        countSampled(engine);
+    }
+    else
+    {
+        countHashed(engine);
+    }
+
+    // Shared above the worst score, which can be negative
+    const auto hasLowerScore = [] (const Phenotype& a, const Phenotype& b) { return a.score() < b.score(); };
+    const double worst = std::min_element(population.begin(), population.end(), hasLowerScore)->score();
+
+    m_sharedScores.resize(m_size);
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        m_sharedScores[i] = (population[i].score() - worst) / m_nicheSizes[i];
+    }
+
+    return m_sharedScores;
+}
+
+double Niching::distance(const Phenotype& a, const Phenotype& b)
+{
+    const std::size_t size = std::max(a.size(), b.size());
+    if (size == 0)
+        return 0.0;
+
+    std::uint32_t sum = 0;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const Gene geneA = i < a.size() ? a.gene(i) : Gene{0, 0};
+        const Gene geneB = i < b.size() ? b.gene(i) : Gene{0, 0};
+        sum += std::abs(geneA.angle - geneB.angle) + s_thrustWeight * std::abs(geneA.thrust - geneB.thrust);
+    }
+
+    return sum / (2.0 * size);
+}
+
+void Niching::pack(const std::vector<Phenotype>& population)
+{
+    std::size_t longest = 0;
+    for (const Phenotype& phenotype : population)
+    {
+        longest = std::max(longest, phenotype.size());
+    }
+
+    // Rows padded to 16 bytes with zero deltas, which add no distance
+    m_size = population.size();
+    m_stride = (2 * longest + 15) / 16 * 16;
+    m_radius = m_config.radius * 2.0 * std::max<std::size_t>(longest, 1);
+    m_keys.assign(m_size * m_stride, static_cast<std::uint8_t>(s_keyOffset));
+
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        std::uint8_t* key = m_keys.data() + i * m_stride;
+        for (const Gene& gene : population[i].genes())
+        {
+            *key++ = angleKey(gene);
+            *key++ = thrustKey(gene);
+        }
+    }
+}
+
+std::uint32_t Niching::packedDistance(std::size_t a, std::size_t b) const noexcept
+{
+    return sumOfAbsoluteDifferences(m_keys.data() + a * m_stride, m_keys.data() + b * m_stride, m_stride);
+}
+
+double Niching::sharing(std::uint32_t distance) const noexcept
+{
+    return distance < m_radius ? 1.0 - distance / m_radius : 0.0;
+}
+
+void Niching::countExactly()
+{
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        for (std::size_t j = i + 1; j < m_size; ++j)
+        {
+            const double shared = sharing(packedDistance(i, j));
+            m_nicheSizes[i] += shared;
+            m_nicheSizes[j] += shared;
+        }
+    }
+}
+
+void Niching::countSampled(utils::RandomEngine& engine)
+{
+    // Each sampled genome stands for (N - 1) / samples genomes
+    const double weight = static_cast<double>(m_size - 1) / m_config.samples;
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        double sum = 0.0;
+        for (std::size_t s = 0; s < m_config.samples; ++s)
+        {
+            std::size_t j = utils::uniform(engine, 0, static_cast<int>(m_size) - 2);
+            j += j >= i ? 1 : 0;
+            sum += sharing(packedDistance(i, j));
+        }
+
+        m_nicheSizes[i] += weight * sum;
+    }
+}
+
+void Niching::countHashed(utils::RandomEngine& engine)
+{
+    // Bit sampling : each bit compares one random coordinate with its value in
+    // a random genome. Genomes a few mutations apart mostly agree on every bit.
+    // There are enough bits for buckets of about the number of samples.
+    const std::size_t bits = std::clamp<std::size_t>(static_cast<std::size_t>(std::log2(static_cast<double>(m_size) / m_config.samples)), 1, 24);
+
+    std::vector<std::size_t> coordinates(bits);
+    std::vector<std::uint8_t> thresholds(bits);
+    for (std::size_t bit = 0; bit < bits; ++bit)
+    {
+        coordinates[bit] = utils::uniform(engine, 0, static_cast<int>(m_stride) - 1);
+        thresholds[bit] = m_keys[utils::uniform(engine, 0, static_cast<int>(m_size) - 1) * m_stride + coordinates[bit]];
+    }
+
+    std::vector<std::uint32_t> hashes(m_size, 0);
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        const std::uint8_t* key = m_keys.data() + i * m_stride;
+        for (std::size_t bit = 0; bit < bits; ++bit)
+        {
+            hashes[i] |= static_cast<std::uint32_t>(key[coordinates[bit]] > thresholds[bit]) << bit;
+        }
+    }
+
+    // Genomes sorted by bucket, then every pair of a bucket
+    std::vector<std::uint32_t> order(m_size);
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        order[i] = static_cast<std::uint32_t>(i);
+    }
+    std::sort(order.begin(), order.end(), [&hashes] (std::uint32_t a, std::uint32_t b)
+    {
+        return hashes[a] < hashes[b] || (hashes[a] == hashes[b] && a < b);
+    });
+
+    for (std::size_t first = 0; first < m_size;)
+    {
+        std::size_t last = first;
+        while (last < m_size && hashes[order[last]] == hashes[order[first]])
+        {
+            ++last;
+        }
+
+        for (std::size_t a = first; a < last; ++a)
+        {
+            for (std::size_t b = a + 1; b < last; ++b)
+            {
+                const double shared = sharing(packedDistance(order[a], order[b]));
+                m_nicheSizes[order[a]] += shared;
+                m_nicheSizes[order[b]] += shared;
+            }
+        }
+
+        first = last;
+    }
+}
+
+NichingMethod nichingFromName(const std::string& name)
+{
+    for (NichingMethod method : {NichingMethod::NONE, NichingMethod::SHARING, NichingMethod::CROWDING})
+    {
+        if (nichingName(method) == name)
+            return method;
+    }
+
+    throw std::invalid_argument("nichingFromName - Unknown niching method " + name);
+}
+
+std::string nichingName(NichingMethod method)
+{
+    switch (method)
+    {
+        case NichingMethod::NONE:     return "none";
+        case NichingMethod::SHARING:  return "sharing";
+        case NichingMethod::CROWDING: return "crowding";
+    }
+
+    return "unknown";
+}
+
+NichingApproximation nichingApproximationFromName(const std::string& name)
+{
+    for (NichingApproximation approximation : {NichingApproximation::EXACT, NichingApproximation::SAMPLING, NichingApproximation::LSH})
+    {
+        if (nichingApproximationName(approximation) == name)
+            return approximation;
+    }
+
+    throw std::invalid_argument("nichingApproximationFromName - Unknown approximation " + name);
+}
+
+std::string nichingApproximationName(NichingApproximation approximation)
+{
+    switch (approximation)
+    {
+        case NichingApproximation::EXACT:    return "exact";
+        case NichingApproximation::SAMPLING: return "sampling";
+        case NichingApproximation::LSH:      return "lsh";
+    }
+
+    return "unknown";
+}
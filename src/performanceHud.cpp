@@ -0,0 +1,233 @@
+#include "performanceHud.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Transform.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+const sf::Time PerformanceHud::s_refreshPeriod = sf::seconds(0.5f);
+
+namespace
+{
+    const float s_width = 250.0f;
+    const float s_lineHeight = 16.0f;
+    const float s_valueOffset = 150.0f;
+    const unsigned s_characterSize = 13u;
+
+    // Sparkline of the best scores between s_lowestScore and 100
+    const float s_sparklineTop = 6.0f * 16.0f + 10.0f;
+    const float s_sparklineHeight = 40.0f;
+    const float s_sparklineStep = 2.0f;
+    const double s_lowestScore = 60.0;
+}
+
+PerformanceHud::PerformanceHud()
+    : m_isVisible(false)
+    , m_sparklineHead(0)
+    , m_sparklineSize(0)
+    , m_recordedIterations(0)
+    , m_hasBaseline(false)
+    , m_iterations(0)
+    , m_steps(0)
+    , m_collisionTests(0)
+    , m_cpuTime(0)
+{
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::array<std::string, NUMBER_OF_LINES> labels{"Generations / s", "Steps / s", "Collision tests / s", "Frame time (max)",
+                                                          "Solver / generation", "CPU (" + std::to_string(threads) + " threads)"};
+
+    m_background.setSize(sf::Vector2f(s_width, s_sparklineTop + s_sparklineHeight + 6.0f));
+    m_background.setFillColor(sf::Color(0, 0, 0, 180));
+    m_background.setOutlineColor(sf::Color(255, 255, 255, 60));
+    m_background.setOutlineThickness(1.0f);
+
+    for (std::size_t line = 0; line < NUMBER_OF_LINES; ++line)
+    {
+        for (sf::Text* text : {&m_labels[line], &m_values[line]})
+        {
+            text->setCharacterSize(s_characterSize);
+            text->setFillColor(sf::Color::White);
+        }
+
+        m_labels[line].setString(labels[line]);
+        m_labels[line].setPosition(6.0f, 4.0f + line * s_lineHeight);
+        m_values[line].setPosition(s_valueOffset, 4.0f + line * s_lineHeight);
+        m_formattedValues[line][0] = '\0';
+    }
+
+    for (std::size_t slot = 0; slot < s_sparklineLength; ++slot)
+    {
+        m_sparkline[slot].color = sf::Color::Green;
+    }
+}
+
+PerformanceHud::~PerformanceHud()
+{
+
+}
+
+void PerformanceHud::setFont(const sf::Font& font)
+{
+    for (std::size_t line = 0; line < NUMBER_OF_LINES; ++line)
+    {
+        m_labels[line].setFont(font);
+        m_values[line].setFont(font);
+    }
+}
+
+void PerformanceHud::toggle() noexcept
+{
+    m_isVisible = !m_isVisible;
+
+    // The rates are measured again from the moment it shows
+    m_hasBaseline = false;
+}
+
+bool PerformanceHud::isVisible() const noexcept
+{
+    return m_isVisible;
+}
+
+void PerformanceHud::recordFrame(sf::Time frameTime) noexcept
+{
+    m_longestFrame = std::max(m_longestFrame, frameTime);
+}
+
+bool PerformanceHud::update(sf::Time dt, const Simulator& simulator)
+{
+    // The scores are recorded even when hidden, so that the sparkline is full
+    // when it shows
+    const bool hasNewScore = recordScore(simulator);
+
+    if (!m_isVisible)
+        return false;
+
+    if (!m_hasBaseline)
+    {
+        refresh(simulator);
+        m_hasBaseline = true;
+        return true;
+    }
+
+    // A new run resets the counters : the rates start over from there
+    if (simulator.numberOfIterations() < m_iterations || simulator.numberOfSteps() < m_steps ||
+        simulator.numberOfCollisionTests() < m_collisionTests)
+    {
+        refresh(simulator);
+        return hasNewScore;
+    }
+
+    m_elapsedTime += dt;
+    if (m_elapsedTime < s_refreshPeriod)
+        return hasNewScore;
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_wallTime).count();
+    const double cpuSeconds = static_cast<double>(std::clock() - m_cpuTime) / CLOCKS_PER_SEC;
+    const double threads = std::max(1u, std::thread::hardware_concurrency());
+
+    bool hasChanged = hasNewScore;
+    hasChanged |= setValue(GENERATIONS, "%.1f", (simulator.numberOfIterations() - m_iterations) / seconds);
+    hasChanged |= setValue(STEPS, "%.3g", (simulator.numberOfSteps() - m_steps) / seconds);
+    hasChanged |= setValue(COLLISION_TESTS, "%.3g", (simulator.numberOfCollisionTests() - m_collisionTests) / seconds);
+    hasChanged |= setValue(FRAME_TIME, "%.2f ms", 1000.0 * m_longestFrame.asSeconds());
+    hasChanged |= setValue(GENERATION_TIME, "%.2f ms", 1000.0 * simulator.generationTime().asSeconds());
+    hasChanged |= setValue(CPU_USAGE, "%.0f %%", 100.0 * cpuSeconds / (seconds * threads));
+
+    refresh(simulator);
+
+    return hasChanged;
+}
+
+void PerformanceHud::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (!m_isVisible)
+        return;
+
+    states.transform *= getTransform();
+
+    target.draw(m_background, states);
+    for (std::size_t line = 0; line < NUMBER_OF_LINES; ++line)
+    {
+        target.draw(m_labels[line], states);
+        target.draw(m_values[line], states);
+    }
+
+    // Oldest part of the ring first, each part moved to its place on the line
+    const std::size_t oldest = m_sparklineSize < s_sparklineLength ? 0 : m_sparklineHead;
+    const std::size_t oldestCount = m_sparklineSize - oldest;
+
+    sf::RenderStates oldestStates = states;
+    oldestStates.transform.translate(6.0f - oldest * s_sparklineStep, 0.0f);
+    target.draw(m_sparkline.data() + oldest, oldestCount, sf::LineStrip, oldestStates);
+
+    if (oldest > 0)
+    {
+        sf::RenderStates newestStates = states;
+        newestStates.transform.translate(6.0f + oldestCount * s_sparklineStep, 0.0f);
+        target.draw(m_sparkline.data(), oldest, sf::LineStrip, newestStates);
+
+        // Segment joining the two parts
+        const sf::Vertex joint[2] = {
+            sf::Vertex(sf::Vector2f(6.0f + (oldestCount - 1) * s_sparklineStep, m_sparkline[s_sparklineLength - 1].position.y), sf::Color::Green),
+            sf::Vertex(sf::Vector2f(6.0f + oldestCount * s_sparklineStep, m_sparkline[0].position.y), sf::Color::Green)
+        };
+        target.draw(joint, 2, sf::Lines, states);
+    }
+}
+
+bool PerformanceHud::setValue(Line line, const char* format, double value)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), format, value);
+
+    if (std::strcmp(buffer, m_formattedValues[line].data()) == 0)
+        return false;
+
+    std::memcpy(m_formattedValues[line].data(), buffer, sizeof(buffer));
+    m_values[line].setString(buffer);
+
+    return true;
+}
+
+bool PerformanceHud::recordScore(const Simulator& simulator)
+{
+    const std::size_t iterations = simulator.numberOfIterations();
+
+    // A new run starts over
+    if (iterations < m_recordedIterations)
+    {
+        m_sparklineHead = 0;
+        m_sparklineSize = 0;
+        m_recordedIterations = 0;
+    }
+
+    if (iterations == m_recordedIterations)
+        return false;
+
+    // A single vertex is written per generation
+    const double score = std::clamp(simulator.bestScore(), s_lowestScore, 100.0);
+    const float y = s_sparklineTop + s_sparklineHeight * static_cast<float>((100.0 - score) / (100.0 - s_lowestScore));
+    m_sparkline[m_sparklineHead].position = sf::Vector2f(m_sparklineHead * s_sparklineStep, y);
+
+    m_sparklineHead = (m_sparklineHead + 1) % s_sparklineLength;
+    m_sparklineSize = std::min(m_sparklineSize + 1, s_sparklineLength);
+    m_recordedIterations = iterations;
+
+    return m_isVisible;
+}
+
+void PerformanceHud::refresh(const Simulator& simulator)
+{
+    m_elapsedTime = sf::Time::Zero;
+    m_longestFrame = sf::Time::Zero;
+    m_iterations = simulator.numberOfIterations();
+    m_steps = simulator.numberOfSteps();
+    m_collisionTests = simulator.numberOfCollisionTests();
+    m_cpuTime = std::clock();
+    m_wallTime = std::chrono::steady_clock::now();
+}
@@ -0,0 +1,38 @@
+#include "random.hpp"
+
+#include <ctime>
+
+namespace 
+{
+    utils::RandomEngine randomEngine(utils::timeSeed());
+}
+
+namespace utils
+{
+    int uniform(int inclusiveMin, int inclusiveMax)
+    {
+        return uniform(randomEngine, inclusiveMin, inclusiveMax);
+    }
+
+    double uniform(double inclusiveMin, double exclusiveMax)
+    {
+        return uniform(randomEngine, inclusiveMin, exclusiveMax);
+    }
+
+    int uniform(RandomEngine& engine, int inclusiveMin, int inclusiveMax)
+    {
+        std::uniform_int_distribution<int> distribution(inclusiveMin, inclusiveMax);
+        return distribution(engine);
+    }
+
+    double uniform(RandomEngine& engine, double inclusiveMin, double exclusiveMax)
+    {
+        std::uniform_real_distribution<double> distribution(inclusiveMin, exclusiveMax);
+        return distribution(engine);
+    }
+
+    unsigned long timeSeed()
+    {
+        return static_cast<unsigned long>(std::time(nullptr));
+    }
+}
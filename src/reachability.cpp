@@ -0,0 +1,163 @@
+#include "reachability.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    const float s_infinity = std::numeric_limits<float>::infinity();
+
+    // Touchdown limits of Lander::hasSafelyLanded
+    const double s_maximumLandingSpeedX = 20.0;
+    const double s_maximumLandingSpeedY = 40.0;
+
+    // Beyond it any horizontal speed counts as recoverable
+    const double s_maximumHorizontalSpeed = 150.0;
+
+    const double s_gravity = BasicLander<double>::s_gravity;
+
+    struct Control
+    {
+        double verticalAcceleration;
+        double horizontalBraking;
+    };
+}
+
+void ReachabilityTable::build(double landingHeight, double lowestGround, double zoneTop)
+{
+    m_landingHeight = landingHeight;
+    m_floor = std::min(0.0, lowestGround - landingHeight);
+    m_top = std::max(zoneTop - landingHeight, s_heightStep);
+    m_rows = static_cast<std::uint32_t>(std::ceil((m_top - m_floor) / s_heightStep));
+    m_columns = static_cast<std::uint32_t>(std::ceil((s_maximumSpeed - s_minimumSpeed) / s_speedStep));
+    m_values.assign(std::size_t(m_rows) * m_columns, -s_infinity);
+
+    // Thrust and angle, the sign of the angle only matters for the direction
+    // of the horizontal braking
+    std::vector<Control> controls{{-s_gravity, 0.0}};
+    for (int thrust = 1; thrust <= 4; ++thrust)
+    {
+        for (int angle = 0; angle <= 90; angle += 15)
+        {
+            controls.push_back({thrust * scalar::cosDegree<double>(angle) - s_gravity, thrust * scalar::sinDegree<double>(angle)});
+        }
+    }
+
+    // Gauss-Seidel sweeps until the values settle, they can only grow
+    bool hasChanged = true;
+    for (int sweep = 0; hasChanged && sweep < 1000; ++sweep)
+    {
+        hasChanged = false;
+
+        for (std::uint32_t row = 0; row < m_rows; ++row)
+        {
+            const double lowHeight = m_floor + row * s_heightStep;
+            const double highHeight = lowHeight + s_heightStep;
+
+            for (std::uint32_t column = 0; column < m_columns; ++column)
+            {
+                float& value = m_values[row * m_columns + column];
+                if (value == s_infinity)
+                    continue;
+
+                const double lowSpeed = s_minimumSpeed + column * s_speedStep;
+                const double highSpeed = lowSpeed + s_speedStep;
+                float best = value;
+
+                for (const Control& control : controls)
+                {
+                    // Same update as Lander::simulationStep, for the whole cell
+                    const double acceleration = control.verticalAcceleration;
+                    const double nextLowSpeed = lowSpeed + acceleration;
+                    const double nextHighSpeed = highSpeed + acceleration;
+                    const double nextLowHeight = lowHeight + nextLowSpeed + 0.5 * acceleration;
+                    const double nextHighHeight = highHeight + nextHighSpeed + 0.5 * acceleration;
+
+                    float candidate = maximumValue(nextLowHeight, nextHighHeight, nextLowSpeed, nextHighSpeed);
+
+                    // Touchdown on the landing altitude, coming from above
+                    if (highHeight > 0.0 && nextLowHeight <= 0.0 &&
+                        nextLowSpeed <= s_maximumLandingSpeedY && nextHighSpeed >= -s_maximumLandingSpeedY)
+                    {
+                        candidate = std::max(candidate, static_cast<float>(s_maximumLandingSpeedX));
+                    }
+
+                    best = std::max(best, candidate + static_cast<float>(control.horizontalBraking));
+                }
+
+                if (best >= s_maximumHorizontalSpeed)
+                {
+                    best = s_infinity;
+                }
+
+                if (best > value + 1e-3f)
+                {
+                    value = best;
+                    hasChanged = true;
+                }
+            }
+        }
+    }
+}
+
+float ReachabilityTable::maximumValue(double lowHeight, double highHeight, double lowSpeed, double highSpeed) const noexcept
+{
+    if (highHeight < m_floor || highSpeed < s_minimumSpeed)
+        return -s_infinity;
+
+    if (highHeight >= m_top || highSpeed >= s_maximumSpeed)
+        return s_infinity;
+
+    const auto rowOf = [this] (double height)
+    {
+        return static_cast<std::uint32_t>(std::max(0.0, height - m_floor) / s_heightStep);
+    };
+    const auto columnOf = [] (double speed)
+    {
+        return static_cast<std::uint32_t>(std::max(0.0, speed - s_minimumSpeed) / s_speedStep);
+    };
+
+    const std::uint32_t lastRow = std::min(rowOf(highHeight), m_rows - 1);
+    const std::uint32_t lastColumn = std::min(columnOf(highSpeed), m_columns - 1);
+
+    float value = -s_infinity;
+    for (std::uint32_t row = rowOf(lowHeight); row <= lastRow; ++row)
+    {
+        for (std::uint32_t column = columnOf(lowSpeed); column <= lastColumn; ++column)
+        {
+            value = std::max(value, m_values[row * m_columns + column]);
+        }
+    }
+
+    return value;
+}
+
+void ReachabilityTable::save(std::ostream& stream) const
+{
+    utils::writeBinary(stream, m_landingHeight);
+    utils::writeBinary(stream, m_floor);
+    utils::writeBinary(stream, m_top);
+    utils::writeBinary(stream, m_rows);
+    utils::writeBinary(stream, m_columns);
+    utils::writeBinaryVector(stream, m_values);
+}
+
+ReachabilityTable ReachabilityTable::load(std::istream& stream)
+{
+    ReachabilityTable table;
+    table.m_landingHeight = utils::readBinary<double>(stream);
+    table.m_floor = utils::readBinary<double>(stream);
+    table.m_top = utils::readBinary<double>(stream);
+    table.m_rows = utils::readBinary<std::uint32_t>(stream);
+    table.m_columns = utils::readBinary<std::uint32_t>(stream);
+    table.m_values = utils::readBinaryVector<float>(stream);
+
+    if (!stream || table.m_values.size() != std::size_t(table.m_rows) * table.m_columns)
+    {
+        throw std::runtime_error("ReachabilityTable::load - Invalid reachability table");
+    }
+
+    return table;
+}
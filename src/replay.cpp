@@ -0,0 +1,62 @@
+#include "replay.hpp"
+#include "binaryStream.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+    const char s_magic[4] = {'M', 'L', 'R', 'P'};
+    const std::uint32_t s_version = 1;
+}
+
+void saveReplay(const Replay& replay, const std::string& fileName)
+{
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("saveReplay - Failed to open " + fileName);
+    }
+
+    file.write(s_magic, sizeof(s_magic));
+    utils::writeBinary(file, s_version);
+    utils::writeBinary(file, replay.levelHash);
+    utils::writeBinary(file, replay.seed);
+    utils::writeBinary<std::uint32_t>(file, static_cast<std::uint32_t>(replay.genes.size()));
+    file.write(reinterpret_cast<const char*>(replay.genes.data()), replay.genes.size() * sizeof(Gene));
+
+    if (!file)
+    {
+        throw std::runtime_error("saveReplay - Failed to write " + fileName);
+    }
+}
+
+Replay loadReplay(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("loadReplay - Failed to load " + fileName);
+    }
+
+    char magic[4];
+    file.read(magic, sizeof(magic));
+    if (!file || !std::equal(magic, magic + 4, s_magic) || utils::readBinary<std::uint32_t>(file) != s_version)
+    {
+        throw std::runtime_error("loadReplay - " + fileName + " is not a replay of this version");
+    }
+
+    Replay replay;
+    replay.levelHash = utils::readBinary<std::uint64_t>(file);
+    replay.seed = utils::readBinary<std::uint64_t>(file);
+    replay.genes.resize(utils::readBinary<std::uint32_t>(file));
+    file.read(reinterpret_cast<char*>(replay.genes.data()), replay.genes.size() * sizeof(Gene));
+
+    if (!file)
+    {
+        throw std::runtime_error("loadReplay - " + fileName + " is truncated");
+    }
+
+    return replay;
+}
@@ -0,0 +1,143 @@
+#include "robustEvaluator.hpp"
+#include "random.hpp"
+#include "rollout.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Genomes claimed at once by a thread
+    const std::size_t s_batchSize = 4;
+
+    // Keeps the starts apart from the random stream of the search
+    const std::uint64_t s_seedSalt = 0x9e3779b97f4a7c15ull;
+}
+
+RobustEvaluator::RobustEvaluator(const RobustnessConfig& config, const ControlEncoding& encoding, std::uint64_t seed)
+    : m_config(config)
+    , m_encoding(encoding)
+    , m_seed(seed)
+    , m_quantileIndex(0)
+    , m_levelVersion(0)
+    , m_population(nullptr)
+    , m_nextGenome(0)
+    , m_pool(config.threads, config.pinning)
+{
+    m_arenas.resize(m_pool.size());
+}
+
+RobustEvaluator::~RobustEvaluator()
+{
+
+}
+
+void RobustEvaluator::setLevel(const Lander& lander, std::shared_ptr<const PreparedLevel> level)
+{
+    m_level = std::move(level);
+
+    const LevelData& data = m_level->level.data;
+    utils::RandomEngine engine(static_cast<utils::RandomEngine::result_type>(m_seed ^ s_seedSalt));
+
+    const std::size_t numberOfStarts = std::max<std::size_t>(1, m_config.samples);
+    m_starts.assign(1, lander);
+    while (m_starts.size() < numberOfStarts)
+    {
+        const Point2d position{data.position.x + utils::uniform(engine, -m_config.positionNoise, m_config.positionNoise),
+                               data.position.y + utils::uniform(engine, -m_config.positionNoise, m_config.positionNoise)};
+        const Point2d velocity{data.velocity.x + utils::uniform(engine, -m_config.velocityNoise, m_config.velocityNoise),
+                               data.velocity.y + utils::uniform(engine, -m_config.velocityNoise, m_config.velocityNoise)};
+        const int fuel = std::max(0, data.fuel + utils::uniform(engine, -m_config.fuelNoise, m_config.fuelNoise));
+
+        m_starts.emplace_back(position, velocity, fuel, data.angle, data.thrust);
+    }
+
+    const double quantile = std::clamp(m_config.quantile, 0.0, 1.0);
+    m_quantileIndex = static_cast<std::size_t>(std::floor(quantile * (m_starts.size() - 1)));
+
+    // The threads copy the new level on their next share
+    m_levelVersion++;
+}
+
+const std::vector<RobustEvaluation>& RobustEvaluator::evaluate(const std::vector<Phenotype>& population)
+{
+    m_population = &population;
+    m_evaluations.resize(population.size());
+    m_nextGenome = 0;
+
+    m_pool.run([this] (std::size_t worker) { evaluateShare(worker); });
+
+    return m_evaluations;
+}
+
+bool RobustEvaluator::isLanding(const RobustEvaluation& evaluation) const noexcept
+{
+    // As many failed starts as the quantile allows, but never the nominal one
+    return evaluation.hasNominalLanding && evaluation.numberOfLandings + m_quantileIndex >= m_starts.size();
+}
+
+std::size_t RobustEvaluator::numberOfStarts() const noexcept
+{
+    return m_starts.size();
+}
+
+const std::vector<int>& RobustEvaluator::placement() const noexcept
+{
+    return m_pool.placement();
+}
+
+void RobustEvaluator::evaluateShare(std::size_t worker)
+{
+    // Allocated and filled by this thread, on its own node
+    std::unique_ptr<Arena>& arena = m_arenas[worker];
+    if (!arena || arena->levelVersion != m_levelVersion)
+    {
+        arena = std::make_unique<Arena>();
+        arena->levelVersion = m_levelVersion;
+        arena->terrain = m_level->terrain;
+        arena->starts = m_starts;
+        arena->scores.resize(m_starts.size());
+    }
+
+    const std::size_t size = m_population->size();
+
+    for (std::size_t first = m_nextGenome.fetch_add(s_batchSize); first < size; first = m_nextGenome.fetch_add(s_batchSize))
+    {
+        for (std::size_t id = first; id < std::min(first + s_batchSize, size); ++id)
+        {
+            m_evaluations[id] = evaluateGenome((*m_population)[id], *arena);
+        }
+    }
+}
+
+RobustEvaluation RobustEvaluator::evaluateGenome(const Phenotype& phenotype, Arena& arena) const
+{
+    RobustEvaluation evaluation;
+    Phenotype scored(0);
+    std::vector<double>& scores = arena.scores;
+
+    for (std::size_t start = 0; start < arena.starts.size(); ++start)
+    {
+        const RolloutResult<double> result = rollout(arena.starts[start], phenotype, arena.terrain, m_encoding, [] (const Point2d&) {});
+        scored.computeScore(result.lander, arena.terrain);
+        scores[start] = scored.score();
+
+        evaluation.steps = std::max(evaluation.steps, result.steps);
+        evaluation.flownSteps += result.steps;
+        evaluation.collisionTests += result.collisionTests;
+        if (result.hasLanded)
+        {
+            evaluation.numberOfLandings++;
+        }
+        if (start == 0)
+        {
+            evaluation.hasNominalLanding = result.hasLanded;
+            evaluation.nominalSteps = result.steps;
+        }
+    }
+
+    std::nth_element(scores.begin(), scores.begin() + m_quantileIndex, scores.end());
+    evaluation.score = scores[m_quantileIndex];
+
+    return evaluation;
+}
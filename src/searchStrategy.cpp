@@ -0,0 +1,106 @@
+#include "searchStrategy.hpp"
+#include "geneticStrategy.hpp"
+#include "differentialEvolution.hpp"
+#include "cmaEvolutionStrategy.hpp"
+#include "evolutionStrategy.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+SearchStrategy::SearchStrategy(const SolverConfig& config)
+    : m_config(config)
+{
+
+}
+
+SearchStrategy::~SearchStrategy()
+{
+
+}
+
+void SearchStrategy::saveState(std::ostream&) const
+{
+
+}
+
+void SearchStrategy::loadState(std::istream&)
+{
+
+}
+
+std::size_t SearchStrategy::dimension() const noexcept
+{
+    return 2 * m_config.encoding.numberOfGenes(m_config.geneLength);
+}
+
+std::vector<double> SearchStrategy::randomPoint(utils::RandomEngine& engine) const
+{
+    std::vector<double> point(dimension());
+    for (double& coordinate : point)
+    {
+        coordinate = utils::uniform(engine, -1.0, 1.0);
+    }
+
+    return point;
+}
+
+Phenotype SearchStrategy::decode(const std::vector<double>& point)
+{
+    std::vector<Gene> genes(point.size() / 2);
+
+    for (std::size_t i = 0; i < genes.size(); ++i)
+    {
+        const double angle = std::clamp(point[2 * i], -1.0, 1.0) * 15.0;
+        const double thrust = std::clamp(point[2 * i + 1], -1.0, 1.0);
+        genes[i].angle = static_cast<std::int8_t>(std::lround(angle));
+        genes[i].thrust = static_cast<std::int8_t>(std::lround(thrust));
+    }
+
+    return Phenotype(std::move(genes), 0.0);
+}
+
+std::unique_ptr<SearchStrategy> createStrategy(const SolverConfig& config)
+{
+    switch (config.strategy)
+    {
+        case StrategyType::GENETIC:
+            return std::make_unique<GeneticStrategy>(config);
+        case StrategyType::DIFFERENTIAL_EVOLUTION:
+            return std::make_unique<DifferentialEvolution>(config);
+        case StrategyType::CMA_ES:
+            return std::make_unique<CmaEvolutionStrategy>(config);
+        case StrategyType::EVOLUTION_STRATEGY:
+            return std::make_unique<EvolutionStrategy>(config);
+        case StrategyType::BEAM_SEARCH:
+            throw std::invalid_argument("createStrategy - The beam search is run by the solver, it breeds no population");
+    }
+
+    throw std::invalid_argument("createStrategy - Unknown strategy");
+}
+
+StrategyType strategyFromName(const std::string& name)
+{
+    for (StrategyType type : {StrategyType::GENETIC, StrategyType::DIFFERENTIAL_EVOLUTION,
+                              StrategyType::CMA_ES, StrategyType::EVOLUTION_STRATEGY, StrategyType::BEAM_SEARCH})
+    {
+        if (strategyName(type) == name)
+            return type;
+    }
+
+    throw std::invalid_argument("strategyFromName - Unknown strategy " + name);
+}
+
+std::string strategyName(StrategyType type)
+{
+    switch (type)
+    {
+        case StrategyType::GENETIC:                return "ga";
+        case StrategyType::DIFFERENTIAL_EVOLUTION: return "de";
+        case StrategyType::CMA_ES:                 return "cma";
+        case StrategyType::EVOLUTION_STRATEGY:     return "es";
+        case StrategyType::BEAM_SEARCH:            return "beam";
+    }
+
+    return "unknown";
+}
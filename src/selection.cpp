@@ -0,0 +1,338 @@
+#include "selection.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+namespace
+{
+    // Draws are reduced to [0, s_drawRange), the range of the engine
+    constexpr std::uint64_t s_drawRange = static_cast<std::uint64_t>(utils::RandomEngine::max() - utils::RandomEngine::min()) + 1;
+}
+
+std::size_t Selector::s_tournamentSize = 3;
+double Selector::s_rankPressure = 1.5;
+std::size_t Selector::s_radixSortThreshold = 2048;
+
+Selector::Selector(SelectionMethod method)
+    : m_method(method)
+    , m_nextSampled(0)
+{
+
+}
+
+Selector::~Selector()
+{
+
+}
+
+void Selector::prepare(const std::vector<Phenotype>& population)
+{
+    // Contiguous scores, so that the selection never touches the phenotypes
+    m_scores.resize(population.size());
+    for (std::size_t i = 0; i < population.size(); ++i)
+    {
+        m_scores[i] = population[i].score();
+    }
+
+    prepareScores();
+}
+
+void Selector::prepare(const std::vector<double>& scores)
+{
+    m_scores.assign(scores.begin(), scores.end());
+    prepareScores();
+}
+
+void Selector::prepareScores()
+{
+    if (m_scores.empty())
+    {
+        throw std::invalid_argument("Selector::prepare - The population is empty");
+    }
+
+    if (m_method == SelectionMethod::RANK)
+    {
+        rankScores();
+
+        // The probability of a rank only depends on the population size, the
+        // table is only rebuilt when it changes
+        if (m_aliases.size() != m_scores.size())
+        {
+            computeRankProbabilities(m_scores.size());
+            buildAliasTable();
+        }
+    }
+    else if (m_method != SelectionMethod::TOURNAMENT)
+    {
+        computeFitnessProbabilities();
+
+        if (m_method == SelectionMethod::STOCHASTIC_UNIVERSAL)
+        {
+            m_sampled.clear();
+            m_nextSampled = 0;
+        }
+        else
+        {
+            buildAliasTable();
+        }
+    }
+}
+
+std::size_t Selector::select(utils::RandomEngine& engine)
+{
+    if (m_method == SelectionMethod::TOURNAMENT)
+    {
+        std::size_t bestIndex = drawIndex(engine, m_scores.size());
+        for (std::size_t i = 1; i < s_tournamentSize; ++i)
+        {
+            const std::size_t candidateIndex = drawIndex(engine, m_scores.size());
+            if (m_scores[candidateIndex] > m_scores[bestIndex])
+            {
+                bestIndex = candidateIndex;
+            }
+        }
+
+        return bestIndex;
+    }
+
+    if (m_method == SelectionMethod::STOCHASTIC_UNIVERSAL)
+    {
+        if (m_nextSampled == m_sampled.size())
+        {
+            sampleUniversally(engine);
+        }
+
+        return m_sampled[m_nextSampled++];
+    }
+
+    // A single draw gives both the column, and the coin of the column in the
+    // remainder of the scaling
+    const std::uint64_t scaled = nextDraw(engine) * m_aliases.size();
+    const std::size_t column = static_cast<std::size_t>(scaled / s_drawRange);
+    const std::size_t entry = scaled % s_drawRange < m_thresholds[column] ? column : m_aliases[column];
+
+    return m_method == SelectionMethod::RANK ? m_ranking[entry] : entry;
+}
+
+SelectionMethod Selector::method() const noexcept
+{
+    return m_method;
+}
+
+void Selector::rankScores()
+{
+    // Best individual first, ties kept in population order. The scores are
+    // sorted as integer keys whose ascending order is the descending order of
+    // the scores.
+    m_rankedScores.resize(m_scores.size());
+    for (std::size_t i = 0; i < m_scores.size(); ++i)
+    {
+        const double score = m_scores[i];
+        std::uint64_t bits;
+        std::memcpy(&bits, &score, sizeof(bits));
+
+        const std::uint64_t ascendingKey = (bits >> 63) ? ~bits : bits ^ (1ull << 63);
+        m_rankedScores[i] = {~ascendingKey, static_cast<std::uint32_t>(i)};
+    }
+
+    if (m_rankedScores.size() < s_radixSortThreshold)
+    {
+        std::sort(m_rankedScores.begin(), m_rankedScores.end(), [] (const RankedScore& a, const RankedScore& b)
+        {
+            return a.key < b.key || (a.key == b.key && a.index < b.index);
+        });
+    }
+    else
+    {
+        radixSort();
+    }
+
+    m_ranking.resize(m_scores.size());
+    for (std::size_t rank = 0; rank < m_ranking.size(); ++rank)
+    {
+        m_ranking[rank] = m_rankedScores[rank].index;
+    }
+}
+
+void Selector::radixSort()
+{
+    // Least significant digit first, each pass being stable keeps the ties in
+    // population order. The scores of a generation usually share their upper
+    // bits, and the passes where every key has the same digit are skipped.
+    constexpr std::size_t digitBits = 11;
+    constexpr std::size_t numberOfBuckets = std::size_t(1) << digitBits;
+
+    m_sortBuffer.resize(m_rankedScores.size());
+    std::vector<std::size_t> offsets(numberOfBuckets);
+
+    for (std::size_t shift = 0; shift < 64; shift += digitBits)
+    {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (const RankedScore& rankedScore : m_rankedScores)
+        {
+            offsets[(rankedScore.key >> shift) & (numberOfBuckets - 1)]++;
+        }
+
+        if (offsets[(m_rankedScores.front().key >> shift) & (numberOfBuckets - 1)] == m_rankedScores.size())
+            continue;
+
+        std::size_t total = 0;
+        for (std::size_t& offset : offsets)
+        {
+            const std::size_t count = offset;
+            offset = total;
+            total += count;
+        }
+
+        for (const RankedScore& rankedScore : m_rankedScores)
+        {
+            m_sortBuffer[offsets[(rankedScore.key >> shift) & (numberOfBuckets - 1)]++] = rankedScore;
+        }
+
+        m_rankedScores.swap(m_sortBuffer);
+    }
+}
+
+void Selector::computeRankProbabilities(std::size_t size)
+{
+    // Indexed by rank, select() maps them back to the individuals
+    m_probabilities.resize(size);
+    const double n = static_cast<double>(size);
+    for (std::size_t rank = 0; rank < size; ++rank)
+    {
+        // Linear ranking
+        m_probabilities[rank] = size == 1 ? 1.0 : (2.0 - s_rankPressure) / n + 2.0 * (n - 1 - rank) * (s_rankPressure - 1.0) / (n * (n - 1));
+    }
+}
+
+void Selector::computeFitnessProbabilities()
+{
+    // Scores can be negative : the fitness is the distance to the worst score,
+    // with a small floor so that nobody is left out entirely
+    const auto bounds = std::minmax_element(m_scores.begin(), m_scores.end());
+    const double worst = *bounds.first;
+    const double floor = std::max(1e-3 * (*bounds.second - worst), 1e-9);
+
+    m_probabilities.resize(m_scores.size());
+    double sum = 0.0;
+    for (std::size_t i = 0; i < m_scores.size(); ++i)
+    {
+        m_probabilities[i] = m_scores[i] - worst + floor;
+        sum += m_probabilities[i];
+    }
+
+    for (double& probability : m_probabilities)
+    {
+        probability /= sum;
+    }
+}
+
+void Selector::buildAliasTable()
+{
+    // Vose's alias method
+    const std::size_t size = m_probabilities.size();
+    m_thresholds.assign(size, s_drawRange);
+    m_aliases.resize(size);
+    std::iota(m_aliases.begin(), m_aliases.end(), 0);
+
+    std::vector<double> scaled(size);
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        scaled[i] = m_probabilities[i] * size;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        const std::uint32_t less = small.back();
+        small.pop_back();
+        const std::uint32_t more = large.back();
+
+        m_thresholds[less] = static_cast<std::uint64_t>(scaled[less] * s_drawRange);
+        m_aliases[less] = more;
+
+        scaled[more] -= 1.0 - scaled[less];
+        if (scaled[more] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+
+    // Whatever is left only differs from 1 by rounding errors, and keeps a full column
+}
+
+void Selector::sampleUniversally(utils::RandomEngine& engine)
+{
+    // One pointer per individual, evenly spaced from a single random offset
+    const std::size_t size = m_probabilities.size();
+    const double spacing = 1.0 / size;
+    double pointer = spacing * static_cast<double>(nextDraw(engine)) / s_drawRange;
+    double cumulated = 0.0;
+
+    m_sampled.clear();
+    for (std::size_t i = 0; i < size && m_sampled.size() < size; ++i)
+    {
+        cumulated += m_probabilities[i];
+        while (pointer < cumulated && m_sampled.size() < size)
+        {
+            m_sampled.push_back(static_cast<std::uint32_t>(i));
+            pointer += spacing;
+        }
+    }
+
+    // Rounding can leave the last pointers past the final sum
+    while (m_sampled.size() < size)
+    {
+        m_sampled.push_back(static_cast<std::uint32_t>(size - 1));
+    }
+
+    // The sampled individuals are paired in a random order
+    for (std::size_t i = size - 1; i > 0; --i)
+    {
+        std::swap(m_sampled[i], m_sampled[drawIndex(engine, i + 1)]);
+    }
+
+    m_nextSampled = 0;
+}
+
+std::uint64_t Selector::nextDraw(utils::RandomEngine& engine)
+{
+    return static_cast<std::uint64_t>(engine() - utils::RandomEngine::min());
+}
+
+std::size_t Selector::drawIndex(utils::RandomEngine& engine, std::size_t size)
+{
+    // Fixed-point scaling of the draw, the bias is negligible for populations
+    // much smaller than the range of the engine
+    return static_cast<std::size_t>(nextDraw(engine) * size / s_drawRange);
+}
+
+SelectionMethod selectionFromName(const std::string& name)
+{
+    for (SelectionMethod method : {SelectionMethod::TOURNAMENT, SelectionMethod::RANK,
+                                   SelectionMethod::STOCHASTIC_UNIVERSAL, SelectionMethod::ROULETTE})
+    {
+        if (selectionName(method) == name)
+            return method;
+    }
+
+    throw std::invalid_argument("selectionFromName - Unknown selection " + name);
+}
+
+std::string selectionName(SelectionMethod method)
+{
+    switch (method)
+    {
+        case SelectionMethod::TOURNAMENT:           return "tournament";
+        case SelectionMethod::RANK:                 return "rank";
+        case SelectionMethod::STOCHASTIC_UNIVERSAL: return "sus";
+        case SelectionMethod::ROULETTE:             return "roulette";
+    }
+
+    return "unknown";
+}
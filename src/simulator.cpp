@@ -3,26 +3,24 @@
 
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/System/Clock.hpp>
 
 #include <string>
 #include <algorithm>
 #include <numeric>
 #include <cassert>
 #include <iostream>
+#include <stdexcept>
 
-size_t Simulator::s_populationSize = 100;
-size_t Simulator::s_geneLength = 160;
 sf::Time Simulator::s_deltaUpdateTime = sf::seconds(0.06f);
-double Simulator::s_crossoverRate = 0.95;
-double Simulator::s_mutationRate = 0.03;
+RecordingPolicy Simulator::s_recordingPolicy = RecordingPolicy::SAMPLED;
+std::size_t Simulator::s_recordingSampleSize = 100;
 
 Simulator::Simulator()
-    : m_trajectories(sf::LineStrip)
-    , m_landingLine(2)
-    , m_numberOfIterations(0)
+    : m_bestScore(0.0)
     , m_status(Status::IDLE)
 {
-
+    m_landerShape.setPosition(-50.f, -50.f); // hide the lander
 }
 
 Simulator::~Simulator()
@@ -30,178 +28,97 @@ Simulator::~Simulator()
 
 }
 
-void Simulator::run(const Point2d& position, const Point2d& velocity, int fuel, int angle, int thrust, const Polyline& surfacePoints)
+void Simulator::run(std::shared_ptr<const PreparedLevel> level)
 {
     clear();
 
-    m_lander = Lander(position, velocity, fuel, angle, thrust);
-	m_population = generateInitialPopulation(s_geneLength);
-    m_status = Status::RUNNING;
+    const Point2d position = level->level.data.position;
+    m_solver.run(std::move(level));
+    start(position);
+}
 
-    m_surfacePoints = surfacePoints;
-    auto hasSameYCoordinate = [] (const Point2d& p, const Point2d& q) { return p.y == q.y; };
-    auto iter = std::adjacent_find(surfacePoints.begin(), surfacePoints.end(), hasSameYCoordinate);
-    assert(iter != surfacePoints.end());
+void Simulator::resume(const std::string& checkpointFileName, const Level& level)
+{
+    clear();
 
-    std::size_t index = std::distance(surfacePoints.begin(), iter);
-    m_landingLine[0] = surfacePoints[index];
-    m_landingLine[1] = surfacePoints[index + 1];
+    m_solver.resume(loadCheckpoint(checkpointFileName), level);
+    start(level.data.position);
 }
 
-void Simulator::geneticIteration()
+void Simulator::updateLevel(std::shared_ptr<const PreparedLevel> level)
 {
-    for (Phenotype& phenotype : m_population)
+    if (m_status == Status::RUNNING)
     {
-        Lander lander = m_lander;
-        sf::VertexArray vertices(sf::LineStrip);
-        vertices.append(sf::Vertex(sf::Vector2f(lander.position().x, lander.position().y)));
-
-        for (std::size_t i = 0; i < phenotype.size(); ++i)
-        {
-            lander.simulationStep(phenotype.gene(i).angle, phenotype.gene(i).thrust);
-            
-            if (auto intersection = hasCrossedSurface(lander.trajectoryLine()); intersection)
-            {
-                vertices.append(sf::Vertex(sf::Vector2f(intersection.value().x, intersection.value().y)));
-
-                if (intersection.value().x >= m_landingLine[0].x &&
-                    intersection.value().x <= m_landingLine[1].x &&
-                    lander.hasSafelyLanded())
-                {
-                    m_trajectories.clear();
-
-                    for (std::size_t vP = 0; vP < vertices.getVertexCount(); ++vP)
-                    {
-                        m_solution.push_back({vertices[vP].position.x, vertices[vP].position.y});
-                        vertices[vP].color = sf::Color(0, 255, 0, 100);
-                    }
-                    std::reverse(m_solution.begin(), m_solution.end());
-                    m_trajectories.push_back(vertices);
-                    m_updateTime = sf::Time::Zero;
-                    m_status = Status::FINISHED;
-                    return;
-                }
-                break;
-            }
-            else
-            {
-                vertices.append(sf::Vertex(sf::Vector2f(lander.position().x, lander.position().y)));
-            }
-        }
-
-        m_trajectories.push_back(vertices);
-        phenotype.computeScore(lander, m_landingLine);
+        m_solver.updateLevel(std::move(level));
     }
-
-    std::vector<Phenotype> newPopulation;
-    for (std::size_t k = 0; k < m_population.size(); ++k)
+    else
     {
-        Phenotype newPhenotype;
-        const double crossoverProbability = utils::uniform(0., 1.);
-        if (crossoverProbability < s_crossoverRate)
-        {
-            Phenotype parent1 = chooseParent();
-            Phenotype parent2 = chooseParent();
-            
-            newPhenotype = arithmeticCrossover(parent1, parent2);
-        }
-        else
-        {
-            newPhenotype = chooseParent();
-        }
-
-        mutate(newPhenotype);
-        newPopulation.push_back(newPhenotype);
+        clear();
+        m_status = Status::IDLE;
     }
-
-    m_population = newPopulation;
 }
 
-std::vector<Phenotype> Simulator::generateInitialPopulation(std::size_t geneLength)
+void Simulator::start(const Point2d& position)
 {
-    std::vector<Phenotype> population;
-    population.reserve(s_populationSize);
-
-    for (std::size_t i = 0; i < s_populationSize; ++i)
-    {
-        population.emplace_back(geneLength);
-    }
-
-    return population;
+    m_landerShape.setPosition(position.x, position.y);
+    m_status = Status::RUNNING;
 }
 
-Phenotype Simulator::chooseParent()
+void Simulator::geneticIteration()
 {
-    // Tournament selection
-    std::size_t bestIndex = utils::uniform(0, m_population.size() - 1);
-    for (std::size_t i = 1; i < 3; ++i)
+    sf::Clock clock;
+    bool hasLanded = false;
+    try
     {
-        const std::size_t candidateIdx = utils::uniform(0, m_population.size() - 1);
-        if (m_population[candidateIdx].score() > m_population[bestIndex].score())
-        {
-            bestIndex = candidateIdx;
-        }
+        hasLanded = m_solver.geneticIteration();
     }
-
-    return m_population[bestIndex];
-}
-
-Phenotype Simulator::arithmeticCrossover(const Phenotype& parent1, const Phenotype& parent2)
-{
-    Phenotype child = parent1;
-    const int leftIdx = utils::uniform(0, parent1.size() - 1);
-    const int rightIdx = utils::uniform(leftIdx, parent1.size() - 1);
-
-    const double alpha = utils::uniform(0., 1.);
-    for (std::size_t i = leftIdx; i <= rightIdx; ++i)
+    catch (const std::runtime_error& e)
     {
-        child.gene(i).thrust = std::round(alpha * child.gene(i).thrust + (1. - alpha) * parent2.gene(i).thrust);
-        child.gene(i).angle = std::round(alpha * child.gene(i).angle + (1. - alpha) * parent2.gene(i).angle);
+        // A search which cannot go on, such as a beam search which gave up
+        std::cerr << e.what() << std::endl;
+        m_status = Status::IDLE;
+        return;
     }
+    m_generationTime = clock.getElapsedTime();
 
-    return child;
-}
+    const std::vector<Phenotype>& population = m_solver.evaluatedPopulation();
+    auto hasLowerScore = [] (const Phenotype& a, const Phenotype& b) { return a.score() < b.score(); };
+    m_bestScore = hasLanded ? 100.0 : std::max_element(population.begin(), population.end(), hasLowerScore)->score();
 
-void Simulator::mutate(Phenotype& phenotype)
-{
-    for (std::size_t i = 0; i < phenotype.size(); ++i)
+    m_trajectories.clear();
+    for (std::size_t individual : m_solver.recordedIndividuals(s_recordingPolicy, s_recordingSampleSize))
     {
-        const double probability = utils::uniform(0., 1.);
-        if (probability < s_mutationRate)
+        const Polyline points = m_solver.trajectory(individual);
+        sf::VertexArray vertices(sf::LineStrip, points.size());
+
+        for (std::size_t vP = 0; vP < points.size(); ++vP)
         {
-            phenotype.gene(i).angle = utils::uniform(-90, 90);
-            phenotype.gene(i).thrust = utils::uniform(-1, 1);
+            vertices[vP].position = sf::Vector2f(points[vP].x, points[vP].y);
+            if (hasLanded)
+                vertices[vP].color = sf::Color(0, 255, 0, 100);
         }
-    }
-}
 
-std::optional<Point2d> Simulator::hasCrossedSurface(const Polyline& line) const
-{
-    assert(2 == line.size());
-    std::optional<Point2d> result = std::nullopt;
+        m_trajectories.push_back(vertices);
+    }
 
-    for (std::size_t i = 0; i < m_surfacePoints.size() - 1; ++i)
+    if (hasLanded)
     {
-        if (utils::doIntersect(m_surfacePoints[i], m_surfacePoints[i + 1], line[0], line[1]))
-        {
-            result = utils::lineLineIntersection(line[0], line[1], m_surfacePoints[i], m_surfacePoints[i + 1]);
-            break;
-        }
+        m_solution = m_solver.trajectory(m_solver.solutionIndex());
+        std::reverse(m_solution.begin(), m_solution.end());
+        m_updateTime = sf::Time::Zero;
+        m_status = Status::FINISHED;
     }
-
-    return result;
 }
 
-void Simulator::update(sf::Time dt)
+bool Simulator::update(sf::Time dt)
 {
 	m_updateTime += dt;
     
     if (m_status == Status::RUNNING && m_updateTime > s_deltaUpdateTime)
     {
         m_updateTime -= s_deltaUpdateTime;
-        m_trajectories.clear();
         geneticIteration();
-        m_numberOfIterations++;
+        return true;
     }
     else if (m_status == Status::FINISHED)
     {
@@ -209,7 +126,7 @@ void Simulator::update(sf::Time dt)
         {
             const std::size_t n = m_solution.size();
             const Point2d newPosition = utils::lerp(m_solution[n-1], m_solution[n-2], m_updateTime.asSeconds() * 10);
-            m_lander.setPosition(newPosition.x, newPosition.y);
+            m_landerShape.setPosition(newPosition.x, newPosition.y);
 
             if (m_updateTime > sf::seconds(0.1f))
             {
@@ -221,7 +138,11 @@ void Simulator::update(sf::Time dt)
         {
             m_status = Status::IDLE;
         }
+
+        return true;
     }
+
+    return false;
 }
 
 void Simulator::render(sf::RenderWindow& window)
@@ -231,7 +152,7 @@ void Simulator::render(sf::RenderWindow& window)
         window.draw(trajectory, utils::scaledScreenTransform());
     }
 
-    window.draw(m_lander);
+    window.draw(m_landerShape);
 }
 
 Simulator::Status Simulator::status() const noexcept
@@ -243,13 +164,45 @@ void Simulator::clear()
 {
     m_trajectories.clear();
     m_updateTime = s_deltaUpdateTime;
-    m_numberOfIterations = 0;
+    m_solver.clear();
     m_solution.clear();
+    m_generationTime = sf::Time::Zero;
+    m_bestScore = 0.0;
+
+    m_landerShape.setPosition(-50.f, -50.f); // hide the lander
+}
 
-    m_lander.setPosition(-50.f, -50.f); // hide the lander
+bool Simulator::hasLanded() const noexcept
+{
+    return m_solver.hasLanded();
+}
+
+void Simulator::saveReplay(const std::string& fileName) const
+{
+    ::saveReplay(m_solver.replay(), fileName);
 }
 
 const std::size_t Simulator::numberOfIterations() const noexcept
 {
-    return m_numberOfIterations;
+    return m_solver.numberOfIterations();
+}
+
+std::size_t Simulator::numberOfSteps() const noexcept
+{
+    return m_solver.numberOfSteps();
+}
+
+std::size_t Simulator::numberOfCollisionTests() const noexcept
+{
+    return m_solver.numberOfCollisionTests();
+}
+
+sf::Time Simulator::generationTime() const noexcept
+{
+    return m_generationTime;
+}
+
+double Simulator::bestScore() const noexcept
+{
+    return m_bestScore;
 }
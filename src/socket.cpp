@@ -0,0 +1,278 @@
+#include "socket.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    const std::string s_unixPrefix = "unix:";
+
+    #ifdef MSG_NOSIGNAL
+    const int s_sendFlags = MSG_NOSIGNAL;
+    #else
+    const int s_sendFlags = 0;
+    #endif
+
+    bool isUnixAddress(const std::string& address)
+    {
+        return address.compare(0, s_unixPrefix.size(), s_unixPrefix) == 0;
+    }
+
+    sockaddr_un unixAddress(const std::string& address)
+    {
+        const std::string path = address.substr(s_unixPrefix.size());
+
+        sockaddr_un socketAddress{};
+        if (path.empty() || path.size() >= sizeof(socketAddress.sun_path))
+        {
+            throw std::runtime_error("Socket - Invalid Unix socket path " + path);
+        }
+
+        socketAddress.sun_family = AF_UNIX;
+        std::strncpy(socketAddress.sun_path, path.c_str(), sizeof(socketAddress.sun_path) - 1);
+
+        return socketAddress;
+    }
+
+    addrinfo* tcpAddresses(const std::string& address, bool isPassive)
+    {
+        const std::size_t separator = address.rfind(':');
+        if (separator == std::string::npos)
+        {
+            throw std::runtime_error("Socket - Invalid address " + address + ", expected unix:<path> or <host>:<port>");
+        }
+
+        const std::string host = address.substr(0, separator);
+        const std::string port = address.substr(separator + 1);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = isPassive ? AI_PASSIVE : 0;
+
+        addrinfo* addresses = nullptr;
+        if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &addresses) != 0)
+        {
+            throw std::runtime_error("Socket - Failed to resolve " + address);
+        }
+
+        return addresses;
+    }
+
+    void disableSigpipe(int descriptor)
+    {
+        #ifdef SO_NOSIGPIPE
+        const int enabled = 1;
+        setsockopt(descriptor, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+        #else
+        (void)descriptor;
+        #endif
+    }
+
+    // Messages are small and answered right away : no Nagle delay
+    void disableDelay(int descriptor, int family)
+    {
+        if (family == AF_INET || family == AF_INET6)
+        {
+            const int enabled = 1;
+            setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+        }
+    }
+}
+
+Socket::Socket() noexcept
+    : m_descriptor(-1)
+{
+
+}
+
+Socket::Socket(int descriptor) noexcept
+    : m_descriptor(descriptor)
+{
+    disableSigpipe(m_descriptor);
+}
+
+Socket::~Socket()
+{
+    close();
+}
+
+Socket::Socket(Socket&& other) noexcept
+    : m_descriptor(std::exchange(other.m_descriptor, -1))
+    , m_unixPath(std::move(other.m_unixPath))
+{
+    other.m_unixPath.clear();
+}
+
+Socket& Socket::operator =(Socket&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_descriptor = std::exchange(other.m_descriptor, -1);
+        m_unixPath = std::move(other.m_unixPath);
+        other.m_unixPath.clear();
+    }
+
+    return *this;
+}
+
+Socket Socket::connect(const std::string& address)
+{
+    if (isUnixAddress(address))
+    {
+        const sockaddr_un socketAddress = unixAddress(address);
+        Socket socket(::socket(AF_UNIX, SOCK_STREAM, 0));
+        if (!socket.isOpen() || ::connect(socket.m_descriptor, reinterpret_cast<const sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0)
+        {
+            throw std::runtime_error("Socket::connect - Failed to connect to " + address + " : " + std::strerror(errno));
+        }
+
+        return socket;
+    }
+
+    addrinfo* addresses = tcpAddresses(address, false);
+    for (addrinfo* candidate = addresses; candidate; candidate = candidate->ai_next)
+    {
+        Socket socket(::socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol));
+        if (socket.isOpen() && ::connect(socket.m_descriptor, candidate->ai_addr, candidate->ai_addrlen) == 0)
+        {
+            disableDelay(socket.m_descriptor, candidate->ai_family);
+            freeaddrinfo(addresses);
+            return socket;
+        }
+    }
+    freeaddrinfo(addresses);
+
+    throw std::runtime_error("Socket::connect - Failed to connect to " + address);
+}
+
+Socket Socket::listen(const std::string& address)
+{
+    if (isUnixAddress(address))
+    {
+        const sockaddr_un socketAddress = unixAddress(address);
+        Socket socket(::socket(AF_UNIX, SOCK_STREAM, 0));
+
+        // A socket file left by a previous run would make bind fail
+        ::unlink(socketAddress.sun_path);
+        if (!socket.isOpen() || ::bind(socket.m_descriptor, reinterpret_cast<const sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0 ||
+            ::listen(socket.m_descriptor, SOMAXCONN) != 0)
+        {
+            throw std::runtime_error("Socket::listen - Failed to listen on " + address + " : " + std::strerror(errno));
+        }
+
+        socket.m_unixPath = socketAddress.sun_path;
+        return socket;
+    }
+
+    addrinfo* addresses = tcpAddresses(address, true);
+    for (addrinfo* candidate = addresses; candidate; candidate = candidate->ai_next)
+    {
+        Socket socket(::socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol));
+        const int enabled = 1;
+        if (socket.isOpen() && setsockopt(socket.m_descriptor, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled)) == 0 &&
+            ::bind(socket.m_descriptor, candidate->ai_addr, candidate->ai_addrlen) == 0 && ::listen(socket.m_descriptor, SOMAXCONN) == 0)
+        {
+            freeaddrinfo(addresses);
+            return socket;
+        }
+    }
+    freeaddrinfo(addresses);
+
+    throw std::runtime_error("Socket::listen - Failed to listen on " + address);
+}
+
+Socket Socket::accept() const
+{
+    sockaddr_storage peerAddress{};
+    socklen_t length = sizeof(peerAddress);
+
+    Socket socket(::accept(m_descriptor, reinterpret_cast<sockaddr*>(&peerAddress), &length));
+    if (!socket.isOpen())
+    {
+        throw std::runtime_error(std::string("Socket::accept - ") + std::strerror(errno));
+    }
+    disableDelay(socket.m_descriptor, peerAddress.ss_family);
+
+    return socket;
+}
+
+bool Socket::sendAll(const char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        const ssize_t sent = ::send(m_descriptor, data, size, s_sendFlags);
+        if (sent < 0 && errno == EINTR)
+            continue;
+        if (sent <= 0)
+            return false;
+
+        data += sent;
+        size -= static_cast<std::size_t>(sent);
+    }
+
+    return true;
+}
+
+bool Socket::receiveAll(char* data, std::size_t size)
+{
+    while (size > 0)
+    {
+        const ssize_t received = ::recv(m_descriptor, data, size, 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received <= 0)
+            return false;
+
+        data += received;
+        size -= static_cast<std::size_t>(received);
+    }
+
+    return true;
+}
+
+bool Socket::setReceiveTimeout(double seconds)
+{
+    timeval timeout{};
+    timeout.tv_sec = static_cast<time_t>(seconds);
+    timeout.tv_usec = static_cast<suseconds_t>((seconds - static_cast<double>(timeout.tv_sec)) * 1e6);
+
+    return setsockopt(m_descriptor, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0;
+}
+
+void Socket::close() noexcept
+{
+    if (m_descriptor >= 0)
+    {
+        ::close(m_descriptor);
+        m_descriptor = -1;
+    }
+
+    // The listening end owns the socket file
+    if (!m_unixPath.empty())
+    {
+        ::unlink(m_unixPath.c_str());
+        m_unixPath.clear();
+    }
+}
+
+bool Socket::isOpen() const noexcept
+{
+    return m_descriptor >= 0;
+}
+
+int Socket::descriptor() const noexcept
+{
+    return m_descriptor;
+}
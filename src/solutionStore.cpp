@@ -0,0 +1,194 @@
+#include "solutionStore.hpp"
+#include "binaryStream.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+    const char s_magic[4] = {'M', 'L', 'S', 'S'};
+    const std::uint32_t s_version = 1;
+
+    const float s_zoneWidth = 7000.0f;
+    const float s_zoneHeight = 3000.0f;
+    const float s_envelopeStep = 500.0f;
+
+    // Highest ground at an abscissa, 0 outside of the surface
+    float groundHeight(const Polyline& surfacePoints, float x)
+    {
+        float height = 0.0f;
+        for (std::size_t i = 0; i + 1 < surfacePoints.size(); ++i)
+        {
+            const Point2d& a = surfacePoints[i];
+            const Point2d& b = surfacePoints[i + 1];
+            if (x < std::min(a.x, b.x) || x > std::max(a.x, b.x))
+                continue;
+
+            const double y = a.x == b.x ? std::max(a.y, b.y) : a.y + (b.y - a.y) * (x - a.x) / (b.x - a.x);
+            height = std::max(height, static_cast<float>(y));
+        }
+
+        return height;
+    }
+}
+
+LevelFeatures levelFeatures(const Level& level)
+{
+    const Polyline landingLine = findLandingLine(level.surfacePoints);
+
+    LevelFeatures features{};
+    std::size_t id = 0;
+    features[id++] = static_cast<float>(level.data.position.x) / s_zoneWidth;
+    features[id++] = static_cast<float>(level.data.position.y) / s_zoneHeight;
+    features[id++] = static_cast<float>(level.data.velocity.x) / 100.0f;
+    features[id++] = static_cast<float>(level.data.velocity.y) / 100.0f;
+    features[id++] = static_cast<float>(level.data.fuel) / 2000.0f;
+    features[id++] = static_cast<float>(level.data.angle) / 90.0f;
+    features[id++] = static_cast<float>(std::min(landingLine[0].x, landingLine[1].x)) / s_zoneWidth;
+    features[id++] = static_cast<float>(std::max(landingLine[0].x, landingLine[1].x)) / s_zoneWidth;
+    features[id++] = static_cast<float>(landingLine[0].y) / s_zoneHeight;
+
+    for (float x = 0.0f; id < features.size(); x += s_envelopeStep)
+    {
+        features[id++] = groundHeight(level.surfacePoints, x) / s_zoneHeight;
+    }
+
+    return features;
+}
+
+void SolutionStore::add(StoredSolution solution)
+{
+    auto known = m_indexByLevel.find(solution.levelHash);
+    if (known != m_indexByLevel.end())
+    {
+        StoredSolution& stored = m_solutions[known->second];
+        solution.coldGenerations = solution.coldGenerations > 0 ? solution.coldGenerations : stored.coldGenerations;
+        stored = std::move(solution);
+        return;
+    }
+
+    m_indexByLevel[solution.levelHash] = m_solutions.size();
+    m_features.insert(m_features.end(), solution.features.begin(), solution.features.end());
+    m_solutions.push_back(std::move(solution));
+}
+
+std::vector<SolutionNeighbour> SolutionStore::nearest(const LevelFeatures& features, std::size_t k, float maxDistance) const
+{
+    // The k best so far, sorted by distance : a solution is only inserted when
+    // it beats the last one, which is rare once the first ones are seen. Ties
+    // keep the order of the store, so that the choice is reproducible.
+    std::vector<SolutionNeighbour> neighbours;
+    neighbours.reserve(k + 1);
+
+    for (std::size_t i = 0; i < m_solutions.size() && k > 0; ++i)
+    {
+        const float* stored = m_features.data() + i * s_numberOfLevelFeatures;
+
+        float distance = 0.0f;
+        for (std::size_t f = 0; f < s_numberOfLevelFeatures; ++f)
+        {
+            const float difference = stored[f] - features[f];
+            distance += difference * difference;
+        }
+
+        if (distance > maxDistance * maxDistance || (neighbours.size() == k && distance >= neighbours.back().distance))
+            continue;
+
+        auto position = std::upper_bound(neighbours.begin(), neighbours.end(), distance, [] (float value, const SolutionNeighbour& neighbour)
+        {
+            return value < neighbour.distance;
+        });
+        neighbours.insert(position, {&m_solutions[i], distance});
+        if (neighbours.size() > k)
+        {
+            neighbours.pop_back();
+        }
+    }
+
+    for (SolutionNeighbour& neighbour : neighbours)
+    {
+        neighbour.distance = std::sqrt(neighbour.distance);
+    }
+
+    return neighbours;
+}
+
+std::size_t SolutionStore::size() const noexcept
+{
+    return m_solutions.size();
+}
+
+void SolutionStore::save(const std::string& fileName) const
+{
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("SolutionStore::save - Failed to open " + fileName);
+    }
+
+    file.write(s_magic, sizeof(s_magic));
+    utils::writeBinary(file, s_version);
+    utils::writeBinary<std::uint64_t>(file, m_solutions.size());
+    for (const StoredSolution& solution : m_solutions)
+    {
+        utils::writeBinary(file, solution.levelHash);
+        utils::writeBinary(file, solution.features);
+        utils::writeBinary(file, solution.coldGenerations);
+        utils::writeBinaryVector(file, solution.genes);
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("SolutionStore::save - Failed to write " + fileName);
+    }
+}
+
+SolutionStore SolutionStore::load(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("SolutionStore::load - Failed to load " + fileName);
+    }
+
+    char magic[4];
+    file.read(magic, sizeof(magic));
+    if (!file || !std::equal(magic, magic + 4, s_magic) || utils::readBinary<std::uint32_t>(file) != s_version)
+    {
+        throw std::runtime_error("SolutionStore::load - " + fileName + " is not a solution store of this version");
+    }
+
+    SolutionStore store;
+    const std::uint64_t size = utils::readBinary<std::uint64_t>(file);
+    for (std::uint64_t i = 0; i < size && file; ++i)
+    {
+        StoredSolution solution;
+        solution.levelHash = utils::readBinary<std::uint64_t>(file);
+        solution.features = utils::readBinary<LevelFeatures>(file);
+        solution.coldGenerations = utils::readBinary<std::uint32_t>(file);
+        solution.genes = utils::readBinaryVector<Gene>(file);
+        store.add(std::move(solution));
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("SolutionStore::load - " + fileName + " is truncated");
+    }
+
+    return store;
+}
+
+Phenotype warmStartGenome(const StoredSolution& solution, const ControlEncoding& encoding)
+{
+    // A gene is repeated over its steps in the stored commands
+    std::vector<Gene> genes;
+    genes.reserve(encoding.numberOfGenes(solution.genes.size()));
+    for (std::size_t step = 0; step < solution.genes.size(); step += encoding.stepsPerGene)
+    {
+        genes.push_back(solution.genes[step]);
+    }
+
+    return Phenotype(std::move(genes), 0.0);
+}
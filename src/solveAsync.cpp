@@ -0,0 +1,142 @@
+#include "solveAsync.hpp"
+#include "solver.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    // Score of a landing, the best a flight can get
+    const double s_landingScore = 100.0;
+
+    double bestScore(const Solver& solver)
+    {
+        if (solver.hasLanded())
+            return s_landingScore;
+
+        double best = 0.0;
+        for (const Phenotype& phenotype : solver.evaluatedPopulation())
+        {
+            best = std::max(best, phenotype.score());
+        }
+
+        return best;
+    }
+
+    Solution cancelledSolution(std::chrono::steady_clock::time_point start)
+    {
+        Solution solution;
+        solution.status = SolveStatus::CANCELLED;
+        solution.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return solution;
+    }
+
+    // The time budget and the reported seconds count from the request, so that
+    // the preparation of the level and the wait for a thread are included
+    Solution solveSince(std::chrono::steady_clock::time_point start, std::shared_ptr<const PreparedLevel> level,
+                        const SolverConfig& config, const SolveOptions& options)
+    {
+        using Clock = std::chrono::steady_clock;
+        if (options.cancellation.isCancelled())
+            return cancelledSolution(start);
+
+        const bool hasTimeBudget = options.timeBudget > Clock::duration::zero();
+        const Clock::time_point deadline = start + options.timeBudget;
+        const std::size_t progressInterval = std::max<std::size_t>(1, options.progressInterval);
+
+        Solver solver(config);
+        solver.run(std::move(level));
+
+        Solution solution;
+        Clock::duration lastIteration = Clock::duration::zero();
+
+        while (true)
+        {
+            if (options.cancellation.isCancelled())
+            {
+                solution.status = SolveStatus::CANCELLED;
+                break;
+            }
+
+            if (options.maxIterations > 0 && solver.numberOfIterations() >= options.maxIterations)
+            {
+                solution.status = SolveStatus::OUT_OF_ITERATIONS;
+                break;
+            }
+
+            const Clock::time_point iterationStart = Clock::now();
+            if (hasTimeBudget && iterationStart + lastIteration > deadline)
+            {
+                solution.status = SolveStatus::OUT_OF_TIME;
+                break;
+            }
+
+            const bool hasLanded = solver.geneticIteration();
+            lastIteration = Clock::now() - iterationStart;
+
+            if (options.onProgress && (hasLanded || solver.numberOfIterations() % progressInterval == 0))
+            {
+                const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                options.onProgress({solver.numberOfIterations(), solver.numberOfEvaluations(), bestScore(solver), seconds});
+            }
+
+            if (hasLanded)
+            {
+                solution.status = SolveStatus::LANDED;
+                solution.replay = solver.replay();
+                break;
+            }
+        }
+
+        solution.numberOfIterations = solver.numberOfIterations();
+        solution.numberOfEvaluations = solver.numberOfEvaluations();
+        solution.bestScore = bestScore(solver);
+        solution.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        return solution;
+    }
+}
+
+CancellationToken::CancellationToken()
+    : m_isCancelled(std::make_shared<std::atomic<bool>>(false))
+{
+
+}
+
+void CancellationToken::cancel() noexcept
+{
+    m_isCancelled->store(true, std::memory_order_relaxed);
+}
+
+bool CancellationToken::isCancelled() const noexcept
+{
+    return m_isCancelled->load(std::memory_order_relaxed);
+}
+
+Solution solve(std::shared_ptr<const PreparedLevel> level, const SolverConfig& config, const SolveOptions& options)
+{
+    return solveSince(std::chrono::steady_clock::now(), std::move(level), config, options);
+}
+
+std::future<Solution> solveAsync(std::shared_ptr<const PreparedLevel> level, const SolverConfig& config, SolveOptions options)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::async(std::launch::async, [start, level = std::move(level), config, options = std::move(options)] ()
+    {
+        return solveSince(start, level, config, options);
+    });
+}
+
+std::future<Solution> solveAsync(const Level& level, const SolverConfig& config, SolveOptions options)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::async(std::launch::async, [start, level, config, options = std::move(options)] ()
+    {
+        // A solve cancelled before it started does not prepare its level
+        if (options.cancellation.isCancelled())
+            return cancelledSolution(start);
+
+        return solveSince(start, levelCache().prepare(level), config, options);
+    });
+}
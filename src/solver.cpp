@@ -0,0 +1,499 @@
+#include "solver.hpp"
+#include "controllerSeeding.hpp"
+#include "rollout.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+Solver::Solver(const SolverConfig& config)
+    : m_config(config)
+    , m_randomEngine(static_cast<utils::RandomEngine::result_type>(config.seed))
+    , m_numberOfIterations(0)
+    , m_numberOfEvaluations(0)
+    , m_numberOfSteps(0)
+    , m_numberOfCollisionTests(0)
+    , m_solutionSteps(0)
+    , m_checkpointInterval(0)
+{
+
+}
+
+Solver::~Solver()
+{
+
+}
+
+void Solver::run(const Level& level)
+{
+    run(levelCache().prepare(level));
+}
+
+void Solver::run(std::shared_ptr<const PreparedLevel> level)
+{
+    clear();
+    setLevel(std::move(level));
+    createRobustEvaluator();
+
+    m_strategy.reset();
+    m_planner.reset();
+
+    // The planner flies its own plans : no seeding, refinement nor robust fitness
+    if (m_config.strategy == StrategyType::BEAM_SEARCH)
+    {
+        if (m_config.encoding.stepsPerGene != 1)
+        {
+            throw std::runtime_error("Solver::run - The beam search plans one command per step");
+        }
+
+        const std::size_t maxSteps = m_config.encoding.isVariableLength() ? m_config.encoding.maxSteps : m_config.geneLength;
+        m_planner = std::make_unique<BeamSearch>(m_config.beamSearch, maxSteps);
+        m_planner->start(m_lander, m_level);
+        m_population = m_planner->population();
+        return;
+    }
+
+    m_strategy = createStrategy(m_config);
+    m_population = m_strategy->initialPopulation(m_randomEngine);
+    seedPopulation();
+}
+
+void Solver::resume(const Checkpoint& checkpoint, const Level& level)
+{
+    std::shared_ptr<const PreparedLevel> preparedLevel = levelCache().prepare(level);
+    if (checkpoint.levelHash != preparedLevel->hash)
+    {
+        throw std::runtime_error("Solver::resume - The checkpoint was not made on this level");
+    }
+
+    if (checkpoint.config.strategy == StrategyType::BEAM_SEARCH)
+    {
+        throw std::runtime_error("Solver::resume - The beam search cannot be resumed from a checkpoint");
+    }
+
+    clear();
+    setLevel(std::move(preparedLevel));
+
+    m_config = checkpoint.config;
+    m_numberOfIterations = checkpoint.numberOfIterations;
+    m_numberOfEvaluations = checkpoint.numberOfEvaluations;
+    m_numberOfSteps = checkpoint.numberOfSteps;
+    m_numberOfCollisionTests = checkpoint.numberOfCollisionTests;
+    m_population = checkpoint.population;
+    createRobustEvaluator();
+
+    std::istringstream stream(checkpoint.randomEngineState);
+    stream >> m_randomEngine;
+
+    m_planner.reset();
+    m_strategy = createStrategy(m_config);
+    std::istringstream strategyStream(checkpoint.strategyState);
+    m_strategy->loadState(strategyStream);
+}
+
+void Solver::updateLevel(std::shared_ptr<const PreparedLevel> level)
+{
+    if (!m_level)
+    {
+        throw std::logic_error("Solver::updateLevel - No level has been run");
+    }
+
+    // A landing found on the former surface may not hold on the new one
+    m_solutionIndex.reset();
+    setLevel(std::move(level));
+
+    if (m_robustEvaluator)
+    {
+        m_robustEvaluator->setLevel(m_lander, m_level);
+    }
+
+    // The states of the beam were flown over the former surface
+    if (m_planner)
+    {
+        m_planner->start(m_lander, m_level);
+        m_population = m_planner->population();
+    }
+}
+
+void Solver::clear()
+{
+    m_population.clear();
+    m_lastGeneration.clear();
+    m_numberOfIterations = 0;
+    m_numberOfEvaluations = 0;
+    m_numberOfSteps = 0;
+    m_numberOfCollisionTests = 0;
+    m_solutionIndex.reset();
+}
+
+void Solver::setLevel(std::shared_ptr<const PreparedLevel> level)
+{
+    const LevelData& data = level->level.data;
+    m_lander = Lander(data.position, data.velocity, data.fuel, data.angle, data.thrust);
+    m_level = std::move(level);
+}
+
+void Solver::createRobustEvaluator()
+{
+    m_robustEvaluator.reset();
+
+    if (m_config.robustness.samples > 0)
+    {
+        m_robustEvaluator = std::make_unique<RobustEvaluator>(m_config.robustness, m_config.encoding, m_config.seed);
+        m_robustEvaluator->setLevel(m_lander, m_level);
+    }
+}
+
+void Solver::seedPopulation()
+{
+    // The other strategies breed from their own continuous points, which the
+    // seeded genomes have none of
+    if (m_config.strategy != StrategyType::GENETIC)
+        return;
+
+    std::size_t id = 0;
+    for (; id < m_warmStart.size() && id < m_population.size(); ++id)
+    {
+        m_population[id] = m_warmStart[id];
+
+        // Fixed-length genomes keep their length through the generations
+        const std::size_t numberOfGenes = m_config.encoding.numberOfGenes(m_config.geneLength);
+        if (!m_config.encoding.isVariableLength() && m_population[id].size() < numberOfGenes)
+        {
+            m_population[id].genes().resize(numberOfGenes, Gene{0, 0});
+        }
+    }
+
+    const double fraction = std::clamp(m_config.seedingFraction, 0.0, 1.0);
+    const std::size_t count = std::min(m_population.size(), id + static_cast<std::size_t>(fraction * m_population.size() + 0.5));
+
+    const ControllerSeeder seeder(m_config.encoding, m_config.geneLength);
+    for (; id < count; ++id)
+    {
+        m_population[id] = seeder.genome(m_lander, m_level->terrain, m_randomEngine);
+    }
+}
+
+bool Solver::geneticIteration()
+{
+    if (m_planner)
+        return plannerIteration();
+
+    // The local search refines the nominal flight, it is left out of the robust fitness
+    const bool hasLanded = m_robustEvaluator ? evaluatePopulationRobustly() : evaluatePopulation() || refineNearMisses();
+    if (hasLanded)
+    {
+        m_numberOfIterations++;
+        return true;
+    }
+
+    // The evaluated generation is kept aside for the display, and its storage
+    // is recycled for the next generation
+    std::vector<Phenotype> newPopulation = std::move(m_lastGeneration);
+    newPopulation.clear();
+    newPopulation.reserve(m_population.size());
+    m_strategy->nextPopulation(m_population, newPopulation, m_randomEngine);
+
+    m_lastGeneration = std::move(m_population);
+    m_population = std::move(newPopulation);
+    m_numberOfIterations++;
+
+    if (m_checkpointWriter && m_numberOfIterations % m_checkpointInterval == 0)
+    {
+        m_checkpointWriter->submit(checkpoint());
+    }
+
+    return false;
+}
+
+bool Solver::evaluatePopulation()
+{
+    for (std::size_t id = 0; id < m_population.size(); ++id)
+    {
+        Phenotype& phenotype = m_population[id];
+        const RolloutResult<double> result = rollout(m_lander, phenotype, m_level->terrain, m_config.encoding, [] (const Point2d&) {});
+        m_numberOfEvaluations++;
+        m_numberOfSteps += result.steps;
+        m_numberOfCollisionTests += result.collisionTests;
+
+        if (result.hasLanded)
+        {
+            m_solutionIndex = id;
+            m_solutionSteps = result.steps;
+            return true;
+        }
+
+        phenotype.computeScore(result.lander, m_level->terrain);
+
+        // The genes that were never flown are dropped, so that breeding only
+        // works on the useful part of the genome
+        if (m_config.encoding.isVariableLength())
+        {
+            phenotype.genes().resize(std::min(phenotype.size(), m_config.encoding.numberOfGenes(result.steps)));
+        }
+    }
+
+    return false;
+}
+
+bool Solver::evaluatePopulationRobustly()
+{
+    const std::vector<RobustEvaluation>& evaluations = m_robustEvaluator->evaluate(m_population);
+
+    for (std::size_t id = 0; id < m_population.size(); ++id)
+    {
+        const RobustEvaluation& evaluation = evaluations[id];
+        Phenotype& phenotype = m_population[id];
+        m_numberOfEvaluations += m_robustEvaluator->numberOfStarts();
+        m_numberOfSteps += evaluation.flownSteps;
+        m_numberOfCollisionTests += evaluation.collisionTests;
+
+        if (m_robustEvaluator->isLanding(evaluation))
+        {
+            m_solutionIndex = id;
+            m_solutionSteps = evaluation.nominalSteps;
+            return true;
+        }
+
+        phenotype.setScore(evaluation.score);
+
+        // Genes flown from any of the starts are kept
+        if (m_config.encoding.isVariableLength())
+        {
+            phenotype.genes().resize(std::min(phenotype.size(), m_config.encoding.numberOfGenes(evaluation.steps)));
+        }
+    }
+
+    return false;
+}
+
+bool Solver::refineNearMisses()
+{
+    const std::size_t count = std::min(m_config.localSearch.individuals, m_population.size());
+    if (count == 0)
+        return false;
+
+    std::vector<std::size_t> indices(m_population.size());
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+        indices[i] = i;
+    }
+
+    // Best first, ties broken by index so that the order is reproducible
+    std::partial_sort(indices.begin(), indices.begin() + count, indices.end(), [this] (std::size_t a, std::size_t b)
+    {
+        return m_population[a].score() > m_population[b].score() || (m_population[a].score() == m_population[b].score() && a < b);
+    });
+
+    // The budget is shared by the refined individuals of the generation
+    LocalSearchConfig config = m_config.localSearch;
+    std::size_t budget = config.evaluations;
+    for (std::size_t i = 0; i < count && budget > 0; ++i)
+    {
+        config.evaluations = budget;
+        const LocalSearchResult result = LocalSearch(config, m_config.encoding).refine(m_population[indices[i]], m_lander, m_level->terrain);
+        m_numberOfEvaluations += result.evaluations;
+        budget -= std::min(budget, result.evaluations);
+
+        if (result.landingSteps)
+        {
+            m_solutionIndex = indices[i];
+            m_solutionSteps = result.landingSteps.value();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Solver::plannerIteration()
+{
+    const bool hasLanded = m_planner->expand();
+    m_numberOfIterations++;
+    m_numberOfEvaluations = m_planner->numberOfRollouts();
+    m_numberOfSteps = m_planner->numberOfSteps();
+    m_numberOfCollisionTests = m_planner->numberOfCollisionTests();
+
+    // The beam is both the evaluated generation and the next one, the landing first
+    m_population = m_planner->population();
+    m_lastGeneration = m_population;
+
+    if (hasLanded)
+    {
+        m_solutionIndex = 0;
+        m_solutionSteps = m_planner->solutionSteps();
+    }
+
+    return hasLanded;
+}
+
+Checkpoint Solver::checkpoint() const
+{
+    Checkpoint checkpoint;
+    checkpoint.levelHash = m_level ? m_level->hash : 0;
+    checkpoint.config = m_config;
+    checkpoint.numberOfIterations = m_numberOfIterations;
+    checkpoint.numberOfEvaluations = m_numberOfEvaluations;
+    checkpoint.numberOfSteps = m_numberOfSteps;
+    checkpoint.numberOfCollisionTests = m_numberOfCollisionTests;
+    checkpoint.population = m_population;
+
+    std::ostringstream stream;
+    stream << m_randomEngine;
+    checkpoint.randomEngineState = stream.str();
+
+    if (m_strategy)
+    {
+        std::ostringstream strategyStream(std::ios::binary);
+        m_strategy->saveState(strategyStream);
+        checkpoint.strategyState = strategyStream.str();
+    }
+
+    return checkpoint;
+}
+
+Replay Solver::replay() const
+{
+    const Phenotype& phenotype = solution();
+    const ControlEncoding& encoding = m_config.encoding;
+
+    // Replays hold one command per flown step, whatever the encoding, so that
+    // they can be verified without the configuration of the solver
+    Replay replay;
+    replay.levelHash = m_level->hash;
+    replay.seed = m_config.seed;
+    replay.genes.reserve(m_solutionSteps);
+    for (std::size_t step = 0; step < m_solutionSteps; ++step)
+    {
+        replay.genes.push_back(geneAtStep(phenotype, encoding, step));
+    }
+
+    return replay;
+}
+
+void Solver::enableCheckpoints(const std::string& fileName, std::size_t interval)
+{
+    m_checkpointWriter.reset();
+
+    if (interval > 0)
+    {
+        m_checkpointWriter = std::make_unique<CheckpointWriter>(fileName);
+        m_checkpointInterval = interval;
+    }
+}
+
+void Solver::setWarmStart(std::vector<Phenotype> genomes)
+{
+    m_warmStart = std::move(genomes);
+}
+
+const SolverConfig& Solver::config() const noexcept
+{
+    return m_config;
+}
+
+const Lander& Solver::lander() const noexcept
+{
+    return m_lander;
+}
+
+const Terrain& Solver::terrain() const
+{
+    if (!m_level)
+    {
+        throw std::logic_error("Solver::terrain - No level has been run");
+    }
+
+    return m_level->terrain;
+}
+
+const std::vector<Phenotype>& Solver::population() const noexcept
+{
+    return m_population;
+}
+
+const std::vector<Phenotype>& Solver::evaluatedPopulation() const noexcept
+{
+    // No new generation is bred once a landing is found
+    return hasLanded() ? m_population : m_lastGeneration;
+}
+
+std::vector<std::size_t> Solver::recordedIndividuals(RecordingPolicy policy, std::size_t sampleSize) const
+{
+    const std::vector<Phenotype>& population = evaluatedPopulation();
+    std::vector<std::size_t> individuals;
+
+    if (population.empty() || policy == RecordingPolicy::NONE)
+        return individuals;
+
+    if (hasLanded())
+    {
+        individuals.push_back(solutionIndex());
+    }
+    else if (policy == RecordingPolicy::BEST_ONLY)
+    {
+        auto hasLowerScore = [] (const Phenotype& a, const Phenotype& b) { return a.score() < b.score(); };
+        auto best = std::max_element(population.begin(), population.end(), hasLowerScore);
+        individuals.push_back(std::distance(population.begin(), best));
+    }
+    else
+    {
+        const std::size_t count = policy == RecordingPolicy::ALL ? population.size() : std::min(sampleSize, population.size());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            individuals.push_back(i * population.size() / count);
+        }
+    }
+
+    return individuals;
+}
+
+Polyline Solver::trajectory(std::size_t individual) const
+{
+    Polyline points{m_lander.position()};
+    auto appendPoint = [&points] (const Point2d& point) { points.push_back(point); };
+
+    rollout(m_lander, evaluatedPopulation()[individual], m_level->terrain, m_config.encoding, appendPoint);
+
+    return points;
+}
+
+std::size_t Solver::numberOfIterations() const noexcept
+{
+    return m_numberOfIterations;
+}
+
+std::size_t Solver::numberOfEvaluations() const noexcept
+{
+    return m_numberOfEvaluations;
+}
+
+std::size_t Solver::numberOfSteps() const noexcept
+{
+    return m_numberOfSteps;
+}
+
+std::size_t Solver::numberOfCollisionTests() const noexcept
+{
+    return m_numberOfCollisionTests;
+}
+
+bool Solver::hasLanded() const noexcept
+{
+    return m_solutionIndex.has_value();
+}
+
+std::size_t Solver::solutionIndex() const noexcept
+{
+    return m_solutionIndex.value_or(0);
+}
+
+const Phenotype& Solver::solution() const
+{
+    if (!m_solutionIndex)
+    {
+        throw std::logic_error("Solver::solution - No landing has been found");
+    }
+
+    return m_population[m_solutionIndex.value()];
+}
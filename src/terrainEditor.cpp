@@ -0,0 +1,192 @@
+#include "terrainEditor.hpp"
+#include "utils.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Window/Event.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    // Half the side of the square drawn on a vertex, and the distance at which it is picked, in pixels
+    const float s_handleSize = 4.0f;
+    const double s_pickDistance = 8.0;
+
+    // Bounds of the zone, in metres
+    const double s_zoneWidth = 7000.0;
+    const double s_zoneHeight = 3000.0;
+
+    Point2d screenToWorld(int x, int y)
+    {
+        const sf::Vector2f point = utils::scaledScreenTransform().getInverse().transformPoint(sf::Vector2f(x, y));
+
+        // Levels are made of whole metres
+        return {std::clamp(std::round(static_cast<double>(point.x)), 0.0, s_zoneWidth - 1.0),
+                std::clamp(std::round(static_cast<double>(point.y)), 0.0, s_zoneHeight - 1.0)};
+    }
+}
+
+TerrainEditor::TerrainEditor()
+    : m_handles(sf::Quads)
+    , m_isEnabled(false)
+{
+
+}
+
+TerrainEditor::~TerrainEditor()
+{
+
+}
+
+void TerrainEditor::setLevel(std::shared_ptr<const PreparedLevel> level)
+{
+    m_level = std::move(level);
+    m_draggedVertex.reset();
+    buildHandles();
+}
+
+void TerrainEditor::setEditedCallback(const std::function<void(std::shared_ptr<const PreparedLevel>)>& editedCallback)
+{
+    m_editedCallback = editedCallback;
+}
+
+void TerrainEditor::toggle() noexcept
+{
+    m_isEnabled = !m_isEnabled;
+    m_draggedVertex.reset();
+}
+
+bool TerrainEditor::isEnabled() const noexcept
+{
+    return m_isEnabled;
+}
+
+bool TerrainEditor::handleEvent(const sf::Event& event)
+{
+    if (!m_isEnabled || !m_level)
+        return false;
+
+    if (event.type == sf::Event::MouseButtonPressed)
+    {
+        const Point2d screenPoint{static_cast<double>(event.mouseButton.x), static_cast<double>(event.mouseButton.y)};
+        const std::optional<std::size_t> vertex = vertexAt(screenPoint);
+
+        if (event.mouseButton.button == sf::Mouse::Left && vertex)
+        {
+            m_draggedVertex = vertex;
+            return true;
+        }
+
+        if (event.mouseButton.button == sf::Mouse::Right && vertex)
+        {
+            edit([&vertex] (Terrain& terrain) { terrain.removeVertex(vertex.value()); });
+            return true;
+        }
+
+        if (event.mouseButton.button == sf::Mouse::Right)
+        {
+            // Into the first segment spanning the cursor, so that the surface keeps its shape elsewhere
+            const Point2d point = screenToWorld(event.mouseButton.x, event.mouseButton.y);
+            const Polyline& surface = m_level->terrain.surfacePoints();
+            for (std::size_t i = 0; i + 1 < surface.size(); ++i)
+            {
+                if (point.x > std::min(surface[i].x, surface[i + 1].x) && point.x < std::max(surface[i].x, surface[i + 1].x))
+                {
+                    edit([i, &point] (Terrain& terrain) { terrain.insertVertex(i + 1, point); });
+                    return true;
+                }
+            }
+        }
+    }
+    else if (event.type == sf::Event::MouseMoved && m_draggedVertex)
+    {
+        const Point2d point = screenToWorld(event.mouseMove.x, event.mouseMove.y);
+        if (point != m_level->terrain.surfacePoints()[m_draggedVertex.value()])
+        {
+            edit([this, &point] (Terrain& terrain) { terrain.moveVertex(m_draggedVertex.value(), point); });
+        }
+        return true;
+    }
+    else if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Left && m_draggedVertex)
+    {
+        m_draggedVertex.reset();
+        return true;
+    }
+
+    return false;
+}
+
+void TerrainEditor::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (m_isEnabled)
+    {
+        target.draw(m_handles, states);
+    }
+}
+
+std::optional<std::size_t> TerrainEditor::vertexAt(const Point2d& screenPoint) const
+{
+    const sf::Transform transform = utils::scaledScreenTransform();
+    const Polyline& surface = m_level->terrain.surfacePoints();
+
+    std::optional<std::size_t> closest;
+    double closestDistance = s_pickDistance;
+    for (std::size_t i = 0; i < surface.size(); ++i)
+    {
+        const sf::Vector2f vertex = transform.transformPoint(sf::Vector2f(surface[i].x, surface[i].y));
+        const double distance = std::hypot(vertex.x - screenPoint.x, vertex.y - screenPoint.y);
+        if (distance <= closestDistance)
+        {
+            closest = i;
+            closestDistance = distance;
+        }
+    }
+
+    return closest;
+}
+
+void TerrainEditor::edit(const std::function<void(Terrain&)>& change)
+{
+    // The former version may still be flown by the solver : the edit is made on a copy
+    std::shared_ptr<PreparedLevel> level = std::make_shared<PreparedLevel>(*m_level);
+    try
+    {
+        change(level->terrain);
+    }
+    catch (const std::runtime_error&)
+    {
+        return;
+    }
+
+    level->level.surfacePoints = level->terrain.surfacePoints();
+    level->hash = levelHash(level->level);
+    m_level = level;
+    buildHandles();
+
+    if (m_editedCallback)
+    {
+        m_editedCallback(m_level);
+    }
+}
+
+void TerrainEditor::buildHandles()
+{
+    m_handles.clear();
+    if (!m_level)
+        return;
+
+    const sf::Transform transform = utils::scaledScreenTransform();
+    for (const Point2d& point : m_level->terrain.surfacePoints())
+    {
+        const sf::Vector2f center = transform.transformPoint(sf::Vector2f(point.x, point.y));
+        const sf::Color color = sf::Color::Yellow;
+
+        m_handles.append(sf::Vertex(sf::Vector2f(center.x - s_handleSize, center.y - s_handleSize), color));
+        m_handles.append(sf::Vertex(sf::Vector2f(center.x + s_handleSize, center.y - s_handleSize), color));
+        m_handles.append(sf::Vertex(sf::Vector2f(center.x + s_handleSize, center.y + s_handleSize), color));
+        m_handles.append(sf::Vertex(sf::Vector2f(center.x - s_handleSize, center.y + s_handleSize), color));
+    }
+}
@@ -0,0 +1,262 @@
+#include "topology.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+    // First line of a sysfs file, empty when missing
+    std::string readLine(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+
+        return line;
+    }
+
+    int readInteger(const std::filesystem::path& path, int fallback)
+    {
+        const std::string line = readLine(path);
+        return line.empty() ? fallback : std::stoi(line);
+    }
+
+    // Processors the process may run on, empty where it cannot be read
+    std::vector<int> allowedCpus()
+    {
+        std::vector<int> cpus;
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if (CPU_ISSET(cpu, &set))
+                    cpus.push_back(cpu);
+            }
+        }
+#endif
+        return cpus;
+    }
+}
+
+CpuTopology CpuTopology::read(const std::string& systemDirectory)
+{
+    const std::filesystem::path cpuDirectory = std::filesystem::path(systemDirectory) / "cpu";
+    const std::vector<int> allowed = allowedCpus();
+    std::vector<int> online = parseCpuList(readLine(cpuDirectory / "online"));
+    if (online.empty())
+    {
+        online = allowed;
+    }
+    else if (!allowed.empty())
+    {
+        // Only the processors of the affinity mask, such as the ones of a
+        // container, unless the mask shares none with the sysfs read
+        std::vector<int> usable;
+        std::set_intersection(online.begin(), online.end(), allowed.begin(), allowed.end(), std::back_inserter(usable));
+        if (!usable.empty())
+            online = std::move(usable);
+    }
+
+    if (online.empty())
+    {
+        return uniform(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    CpuTopology topology;
+    for (int id : online)
+    {
+        const std::filesystem::path directory = cpuDirectory / ("cpu" + std::to_string(id)) / "topology";
+        topology.m_cpus.push_back({id, readInteger(directory / "physical_package_id", 0), readInteger(directory / "core_id", id), 0, 0});
+    }
+
+    // Machines without NUMA have no node directory, and are a single node
+    const std::filesystem::path nodeDirectory = std::filesystem::path(systemDirectory) / "node";
+    for (int node : parseCpuList(readLine(nodeDirectory / "online")))
+    {
+        for (int id : parseCpuList(readLine(nodeDirectory / ("node" + std::to_string(node)) / "cpulist")))
+        {
+            auto cpu = std::find_if(topology.m_cpus.begin(), topology.m_cpus.end(), [id] (const LogicalCpu& c) { return c.id == id; });
+            if (cpu != topology.m_cpus.end())
+            {
+                cpu->node = node;
+            }
+        }
+    }
+
+    // Hardware threads of a core, in the order of their identifiers
+    std::map<std::pair<int, int>, int> threadsPerCore;
+    for (LogicalCpu& cpu : topology.m_cpus)
+    {
+        cpu.thread = threadsPerCore[{cpu.package, cpu.core}]++;
+    }
+
+    return topology;
+}
+
+CpuTopology CpuTopology::uniform(std::size_t numberOfCpus)
+{
+    CpuTopology topology;
+    for (std::size_t i = 0; i < numberOfCpus; ++i)
+    {
+        const int id = static_cast<int>(i);
+        topology.m_cpus.push_back({id, 0, id, 0, 0});
+    }
+
+    return topology;
+}
+
+const std::vector<LogicalCpu>& CpuTopology::cpus() const noexcept
+{
+    return m_cpus;
+}
+
+std::size_t CpuTopology::numberOfNodes() const noexcept
+{
+    return nodeOrders().size();
+}
+
+std::size_t CpuTopology::numberOfPackages() const noexcept
+{
+    std::vector<int> packages;
+    for (const LogicalCpu& cpu : m_cpus)
+    {
+        packages.push_back(cpu.package);
+    }
+    std::sort(packages.begin(), packages.end());
+
+    return std::unique(packages.begin(), packages.end()) - packages.begin();
+}
+
+std::vector<int> CpuTopology::placement(std::size_t numberOfWorkers, PinningPolicy policy) const
+{
+    std::vector<int> cpus;
+    if (policy == PinningPolicy::NONE || m_cpus.empty())
+        return cpus;
+
+    const std::vector<std::vector<int>> orders = nodeOrders();
+    std::vector<int> order;
+    if (policy == PinningPolicy::COMPACT)
+    {
+        for (const std::vector<int>& nodeOrder : orders)
+        {
+            order.insert(order.end(), nodeOrder.begin(), nodeOrder.end());
+        }
+    }
+    else
+    {
+        // The next processor of each node in turn
+        for (std::size_t rank = 0; order.size() < m_cpus.size(); ++rank)
+        {
+            for (const std::vector<int>& nodeOrder : orders)
+            {
+                if (rank < nodeOrder.size())
+                    order.push_back(nodeOrder[rank]);
+            }
+        }
+    }
+
+    for (std::size_t worker = 0; worker < numberOfWorkers; ++worker)
+    {
+        cpus.push_back(order[worker % order.size()]);
+    }
+
+    return cpus;
+}
+
+std::vector<std::vector<int>> CpuTopology::nodeOrders() const
+{
+    std::vector<LogicalCpu> sorted = m_cpus;
+    std::sort(sorted.begin(), sorted.end(), [] (const LogicalCpu& a, const LogicalCpu& b)
+    {
+        return std::tie(a.node, a.thread, a.package, a.core, a.id) < std::tie(b.node, b.thread, b.package, b.core, b.id);
+    });
+
+    std::vector<std::vector<int>> orders;
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+    {
+        if (i == 0 || sorted[i].node != sorted[i - 1].node)
+            orders.emplace_back();
+
+        orders.back().push_back(sorted[i].id);
+    }
+
+    return orders;
+}
+
+bool pinCurrentThread(int cpu)
+{
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+std::vector<int> parseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::istringstream stream(list);
+    std::string range;
+
+    while (std::getline(stream, range, ','))
+    {
+        if (range.empty())
+            continue;
+
+        const std::size_t dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+PinningPolicy pinningFromName(const std::string& name)
+{
+    for (PinningPolicy policy : {PinningPolicy::NONE, PinningPolicy::COMPACT, PinningPolicy::SCATTER})
+    {
+        if (pinningName(policy) == name)
+            return policy;
+    }
+
+    throw std::invalid_argument("pinningFromName - Unknown pinning policy " + name);
+}
+
+std::string pinningName(PinningPolicy policy)
+{
+    switch (policy)
+    {
+        case PinningPolicy::NONE:    return "none";
+        case PinningPolicy::COMPACT: return "compact";
+        case PinningPolicy::SCATTER: return "scatter";
+    }
+
+    return "unknown";
+}
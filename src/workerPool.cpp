@@ -0,0 +1,118 @@
+#include "workerPool.hpp"
+#include "topology.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+WorkerPool::WorkerPool(std::size_t numberOfThreads, PinningPolicy pinning)
+    : m_size(numberOfThreads > 0 ? numberOfThreads : std::max(1u, std::thread::hardware_concurrency()))
+    , m_job(nullptr)
+    , m_generation(0)
+    , m_numberOfBusyThreads(0)
+    , m_isStopping(false)
+    , m_isCallerWorker(true)
+{
+    m_placement = CpuTopology::read().placement(m_size, pinning);
+    m_isCallerWorker = m_placement.empty();
+
+    for (std::size_t i = m_isCallerWorker ? 1 : 0; i < m_size; ++i)
+    {
+        m_threads.emplace_back(&WorkerPool::workLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_startCondition.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(const std::function<void(std::size_t)>& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_error = nullptr;
+        m_numberOfBusyThreads = m_threads.size();
+        m_generation++;
+    }
+    m_startCondition.notify_all();
+
+    if (m_isCallerWorker)
+    {
+        runShare(0);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] () { return m_numberOfBusyThreads == 0; });
+    m_job = nullptr;
+
+    if (m_error)
+        std::rethrow_exception(m_error);
+}
+
+std::size_t WorkerPool::size() const noexcept
+{
+    return m_size;
+}
+
+const std::vector<int>& WorkerPool::placement() const noexcept
+{
+    return m_placement;
+}
+
+void WorkerPool::workLoop(std::size_t worker)
+{
+    if (!m_placement.empty() && !pinCurrentThread(m_placement[worker]))
+    {
+        // Reported once for the whole process
+        static std::once_flag s_reported;
+        std::call_once(s_reported, [cpu = m_placement[worker]] ()
+        {
+            std::cerr << "WorkerPool - Could not pin a thread to processor " << cpu << ", it runs unpinned" << std::endl;
+        });
+    }
+
+    // Generations are counted from the construction, before any thread starts
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::size_t generation = 0;
+
+    while (true)
+    {
+        m_startCondition.wait(lock, [this, generation] () { return m_isStopping || m_generation != generation; });
+        if (m_isStopping)
+            return;
+
+        generation = m_generation;
+        lock.unlock();
+        runShare(worker);
+        lock.lock();
+
+        if (--m_numberOfBusyThreads == 0)
+        {
+            m_doneCondition.notify_one();
+        }
+    }
+}
+
+void WorkerPool::runShare(std::size_t worker)
+{
+    try
+    {
+        (*m_job)(worker);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_error)
+            m_error = std::current_exception();
+    }
+}
@@ -0,0 +1,189 @@
+// Spreads the search over several processes, on one machine or several. The
+// coordinator keeps the islands of an island model and hands them to the
+// workers which connect to it, a few generations at a time.
+//
+// Usage : DISTRIBUTED_SOLVER coordinator <levelFile> [options]
+//         DISTRIBUTED_SOLVER worker <address>
+//
+// Addresses are unix:<path> for a Unix domain socket, or <host>:<port> for TCP.
+// Coordinator options :
+//   --listen <address>         address the workers connect to (default : unix:/tmp/mars-lander.socket)
+//   --islands <n>              number of islands, each with its own seed (default : 4)
+//   --task-generations <n>     generations flown by a worker before reporting (default : 50)
+//   --migrants <n>             individuals migrating to the next island after each task (default : 2)
+//   --max-generations <n>      stop when every island has flown n generations (default : unlimited)
+//   --local-workers <n>        also start n worker processes on this machine (default : 0)
+//   --worker-timeout <s>       give up after s seconds without any connected worker, 0 to wait for ever
+//                              (default : 10 with local workers, 0 otherwise)
+//   --task-timeout <s>         seconds a worker has to report on its task before losing it, 0 for no limit
+//                              (default : 600)
+//   --max-task-failures <n>    abandon the run when the task of an island is lost n times in a row (default : 3)
+//   --seed <n>, --population <n>, --strategy <name>, --selection <name>, --steps-per-gene <n>,
+//   --max-steps <n>, --local-search <n>  configuration of the solver of every island, as for HEADLESS_SOLVER,
+//                              except the beam search which cannot be resumed on a worker
+//   --replay <file>            file where the control sequence of the landing is exported
+
+#include "distributed.hpp"
+#include "levelCache.hpp"
+#include "searchStrategy.hpp"
+#include "selection.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    int runCoordinator(int argc, char* argv[])
+    {
+        if (argc < 3)
+        {
+            throw std::runtime_error("Usage : DISTRIBUTED_SOLVER coordinator <levelFile> [options]");
+        }
+
+        const std::string levelFile = argv[2];
+        CoordinatorConfig config;
+        SolverConfig solverConfig;
+        std::size_t numberOfLocalWorkers = 0;
+        std::optional<double> workerTimeout;
+        std::string replayFile;
+
+        for (int i = 3; i < argc; ++i)
+        {
+            const std::string option = argv[i];
+            if (i + 1 >= argc)
+                throw std::runtime_error("Missing value for option " + option);
+
+            const std::string value = argv[++i];
+            if (option == "--listen")
+                config.address = value;
+            else if (option == "--islands")
+                config.numberOfIslands = std::stoul(value);
+            else if (option == "--task-generations")
+                config.generationsPerTask = std::max<std::size_t>(1, std::stoul(value));
+            else if (option == "--migrants")
+                config.numberOfMigrants = std::stoul(value);
+            else if (option == "--max-generations")
+                config.maxGenerations = std::stoul(value);
+            else if (option == "--local-workers")
+                numberOfLocalWorkers = std::stoul(value);
+            else if (option == "--worker-timeout")
+                workerTimeout = std::stod(value);
+            else if (option == "--task-timeout")
+                config.taskTimeout = std::stod(value);
+            else if (option == "--max-task-failures")
+                config.maxTaskFailures = std::stoul(value);
+            else if (option == "--seed")
+                solverConfig.seed = std::stoull(value);
+            else if (option == "--population")
+                solverConfig.populationSize = std::stoul(value);
+            else if (option == "--strategy")
+                solverConfig.strategy = strategyFromName(value);
+            else if (option == "--selection")
+                solverConfig.selection = selectionFromName(value);
+            else if (option == "--steps-per-gene")
+                solverConfig.encoding.stepsPerGene = std::max<std::size_t>(1, std::stoul(value));
+            else if (option == "--max-steps")
+                solverConfig.encoding.maxSteps = std::stoul(value);
+            else if (option == "--local-search")
+                solverConfig.localSearch.individuals = std::stoul(value);
+            else if (option == "--replay")
+                replayFile = value;
+            else
+                throw std::runtime_error("Unknown option " + option);
+        }
+
+        // Before the workers start, which could not resume its islands
+        if (solverConfig.strategy == StrategyType::BEAM_SEARCH)
+        {
+            throw std::runtime_error("The beam search cannot be distributed");
+        }
+
+        // Local workers connect right away : once they are all gone, none comes back
+        config.workerTimeout = workerTimeout.value_or(numberOfLocalWorkers > 0 ? 10.0 : 0.0);
+
+        const Level level = levelCache().load(levelFile)->level;
+        Coordinator coordinator(config, solverConfig);
+
+        // The workers are started once the coordinator listens. They leave
+        // with _exit, so that they never run the destructors of the parent,
+        // which own the socket file.
+        std::vector<pid_t> localWorkers;
+        for (std::size_t i = 0; i < numberOfLocalWorkers; ++i)
+        {
+            const pid_t pid = fork();
+            if (pid == 0)
+            {
+                int status = 0;
+                try
+                {
+                    runWorker(config.address);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "Worker - " << e.what() << std::endl;
+                    status = 1;
+                }
+                _exit(status);
+            }
+            else if (pid > 0)
+            {
+                localWorkers.push_back(pid);
+            }
+        }
+
+        std::cout << "Waiting for workers on " << config.address << std::endl;
+
+        const auto start = std::chrono::steady_clock::now();
+        const CoordinatorResult result = coordinator.run(level);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (pid_t pid : localWorkers)
+        {
+            waitpid(pid, nullptr, 0);
+        }
+
+        std::cout << (result.replay ? "Landed on island " + std::to_string(result.island) : std::string("No landing"))
+                  << ", " << result.numberOfEvaluations << " evaluations, " << result.numberOfLostTasks
+                  << " lost tasks (" << seconds << " s)" << std::endl;
+
+        if (result.replay && !replayFile.empty())
+        {
+            saveReplay(result.replay.value(), replayFile);
+        }
+
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const std::string mode = argc > 1 ? argv[1] : "";
+        if (mode == "coordinator")
+        {
+            return runCoordinator(argc, argv);
+        }
+
+        if (mode == "worker" && argc > 2)
+        {
+            runWorker(argv[2]);
+            return 0;
+        }
+
+        throw std::runtime_error("Usage : DISTRIBUTED_SOLVER coordinator <levelFile> [options] | worker <address>");
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "\nEXCEPTION: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,287 @@
+// Runs the search on a level without any rendering, for long
+// searches. The solver state can be checkpointed periodically and resumed.
+//
+// Usage : HEADLESS_SOLVER <levelFile> [options]
+//   --seed <n>                 seed of the random engine
+//   --max-iterations <n>       stop after n generations (default : unlimited)
+//   --population <n>           population size
+//   --strategy <name>          search strategy : ga, de, cma, es or beam (default : ga)
+//   --selection <name>         parent selection of ga : tournament, rank, sus or roulette (default : tournament)
+//   --niching <name>           diversity pressure of ga : none, sharing or crowding (default : none)
+//   --niching-radius <d>       radius of a niche, in mean difference per coordinate of the genes (default : 2)
+//   --niching-approximation <name>  niche sizes of the sharing : exact, sampling or lsh (default : exact)
+//   --niching-samples <n>      genomes compared with each one by the approximations (default : 64)
+//   --beam-width <n>           states kept at each depth by the beam search (default : 64)
+//   --beam-max-width <n>       widest beam tried before the beam search gives up (default : 4096)
+//   --beam-steps <n>           steps of each action of the beam search (default : 5)
+//   --beam-threads <n>         threads flying the rollouts of the beam search (default : one per core)
+//   --steps-per-gene <n>       number of steps each gene is applied for (default : 1)
+//   --max-steps <n>            variable-length genomes, flown for up to n steps
+//   --seeding <fraction>       share of the initial population flown by PD controllers (default : 0)
+//   --local-search <n>         refine the n best near misses of each generation (default : 0)
+//   --local-search-genes <n>   number of genes before the impact searched by the refinement (default : 20)
+//   --local-search-budget <n>  rollouts of the refinement per generation (default : 200)
+//   --robust-samples <n>       score every genome on n starts, the nominal one and perturbed ones (default : 0)
+//   --robust-quantile <q>      quantile of the scores of the starts, 0 for the worst case (default : 0)
+//   --robust-noise <p,v,f>     perturbations of the position, velocity and fuel (default : 50,5,50)
+//   --threads <n>              threads flying the robust rollouts (default : one per core)
+//   --pinning <name>           placement of the robust and beam threads : none, compact or scatter (default : none)
+//   --checkpoint <file>        file where checkpoints are written
+//   --checkpoint-interval <n>  write a checkpoint every n generations (default : 100)
+//   --resume <file>            resume from a checkpoint instead of starting over
+//   --level-cache <directory>  directory where the preprocessed levels are kept between runs
+//   --replay <file>            file where the control sequence of the landing is exported
+//   --solution-store <file>    store of past landings : warm starts the search and receives its landing
+//   --warm-start <k>           number of landings of the closest levels put in the initial population (default : 5)
+//   --warm-start-radius <d>    largest distance between the features of the levels for a warm start (default : 0.5)
+
+#include "levelCache.hpp"
+#include "niching.hpp"
+#include "selection.hpp"
+#include "solutionStore.hpp"
+#include "solver.hpp"
+#include "topology.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Digest of the population genes, to compare two runs
+    std::uint64_t populationDigest(const std::vector<Phenotype>& population)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (const Phenotype& phenotype : population)
+        {
+            for (const Gene& gene : phenotype.genes())
+            {
+                hash = (hash ^ static_cast<std::uint8_t>(gene.angle)) * 1099511628211ull;
+                hash = (hash ^ static_cast<std::uint8_t>(gene.thrust)) * 1099511628211ull;
+            }
+        }
+
+        return hash;
+    }
+
+    void parseNoise(const std::string& value, RobustnessConfig& robustness)
+    {
+        std::istringstream stream(value);
+        char separator;
+        if (!(stream >> robustness.positionNoise >> separator >> robustness.velocityNoise >> separator >> robustness.fuelNoise))
+        {
+            throw std::runtime_error("Invalid noise " + value + ", expected <position>,<velocity>,<fuel>");
+        }
+    }
+
+    struct WarmStart
+    {
+        std::vector<Phenotype> genomes;
+        // Mean generations of the cold searches on the neighbours, 0 if unknown
+        double coldGenerations{0.0};
+    };
+
+    WarmStart prepareWarmStart(const SolutionStore& store, const LevelFeatures& features, std::size_t k, float radius,
+                               const ControlEncoding& encoding)
+    {
+        WarmStart warm;
+        const auto start = std::chrono::steady_clock::now();
+        const std::vector<SolutionNeighbour> neighbours = store.nearest(features, k, radius);
+        const double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        if (neighbours.empty())
+        {
+            if (k > 0 && store.size() > 0)
+                std::cout << "No stored landing within " << radius << " of this level, cold start" << std::endl;
+
+            return warm;
+        }
+
+        std::size_t coldSearches = 0;
+        for (const SolutionNeighbour& neighbour : neighbours)
+        {
+            warm.genomes.push_back(warmStartGenome(*neighbour.solution, encoding));
+            if (neighbour.solution->coldGenerations > 0)
+            {
+                warm.coldGenerations += neighbour.solution->coldGenerations;
+                coldSearches++;
+            }
+        }
+        warm.coldGenerations = coldSearches > 0 ? warm.coldGenerations / coldSearches : 0.0;
+
+        std::cout << "Warm start from " << neighbours.size() << " of " << store.size() << " stored landings, closest at "
+                  << neighbours.front().distance << " (query " << microseconds << " us)" << std::endl;
+
+        return warm;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (argc < 2)
+        {
+            throw std::runtime_error("Usage : HEADLESS_SOLVER <levelFile> [options]");
+        }
+
+        const std::string levelFile = argv[1];
+        SolverConfig config;
+        std::size_t maxIterations = 0;
+        std::string checkpointFile;
+        std::size_t checkpointInterval = 100;
+        std::string resumeFile;
+        std::string replayFile;
+        std::string storeFile;
+        std::size_t warmStart = 5;
+        float warmStartRadius = 0.5f;
+
+        for (int i = 2; i < argc; ++i)
+        {
+            const std::string option = argv[i];
+            if (i + 1 >= argc)
+                throw std::runtime_error("Missing value for option " + option);
+
+            const std::string value = argv[++i];
+            if (option == "--seed")
+                config.seed = std::stoull(value);
+            else if (option == "--max-iterations")
+                maxIterations = std::stoul(value);
+            else if (option == "--population")
+                config.populationSize = std::stoul(value);
+            else if (option == "--strategy")
+                config.strategy = strategyFromName(value);
+            else if (option == "--selection")
+                config.selection = selectionFromName(value);
+            else if (option == "--niching")
+                config.niching.method = nichingFromName(value);
+            else if (option == "--niching-radius")
+                config.niching.radius = std::stod(value);
+            else if (option == "--niching-approximation")
+                config.niching.approximation = nichingApproximationFromName(value);
+            else if (option == "--niching-samples")
+                config.niching.samples = std::max<std::size_t>(1, std::stoul(value));
+            else if (option == "--beam-width")
+                config.beamSearch.width = std::max<std::size_t>(1, std::stoul(value));
+            else if (option == "--beam-max-width")
+                config.beamSearch.maxWidth = std::stoul(value);
+            else if (option == "--beam-steps")
+                config.beamSearch.stepsPerAction = std::max<std::size_t>(1, std::stoul(value));
+            else if (option == "--beam-threads")
+                config.beamSearch.threads = std::stoul(value);
+            else if (option == "--steps-per-gene")
+                config.encoding.stepsPerGene = std::max<std::size_t>(1, std::stoul(value));
+            else if (option == "--max-steps")
+                config.encoding.maxSteps = std::stoul(value);
+            else if (option == "--seeding")
+                config.seedingFraction = std::stod(value);
+            else if (option == "--local-search")
+                config.localSearch.individuals = std::stoul(value);
+            else if (option == "--local-search-genes")
+                config.localSearch.tailGenes = std::stoul(value);
+            else if (option == "--local-search-budget")
+                config.localSearch.evaluations = std::stoul(value);
+            else if (option == "--robust-samples")
+                config.robustness.samples = std::stoul(value);
+            else if (option == "--robust-quantile")
+                config.robustness.quantile = std::stod(value);
+            else if (option == "--robust-noise")
+                parseNoise(value, config.robustness);
+            else if (option == "--threads")
+                config.robustness.threads = std::stoul(value);
+            else if (option == "--pinning")
+                config.robustness.pinning = config.beamSearch.pinning = pinningFromName(value);
+            else if (option == "--checkpoint")
+                checkpointFile = value;
+            else if (option == "--checkpoint-interval")
+                checkpointInterval = std::stoul(value);
+            else if (option == "--resume")
+                resumeFile = value;
+            else if (option == "--level-cache")
+                levelCache().setDirectory(value);
+            else if (option == "--replay")
+                replayFile = value;
+            else if (option == "--solution-store")
+                storeFile = value;
+            else if (option == "--warm-start")
+                warmStart = std::stoul(value);
+            else if (option == "--warm-start-radius")
+                warmStartRadius = std::stof(value);
+            else
+                throw std::runtime_error("Unknown option " + option);
+        }
+
+        const std::shared_ptr<const PreparedLevel> preparedLevel = levelCache().load(levelFile);
+        const Level& level = preparedLevel->level;
+        Solver solver(config);
+
+        SolutionStore store;
+        if (!storeFile.empty() && std::filesystem::exists(storeFile))
+        {
+            store = SolutionStore::load(storeFile);
+        }
+        const LevelFeatures features = levelFeatures(level);
+        const WarmStart warm = resumeFile.empty() ? prepareWarmStart(store, features, warmStart, warmStartRadius, config.encoding) : WarmStart{};
+
+        if (resumeFile.empty())
+        {
+            solver.setWarmStart(warm.genomes);
+            solver.run(preparedLevel);
+        }
+        else
+        {
+            solver.resume(loadCheckpoint(resumeFile), level);
+            std::cout << "Resumed at iteration " << solver.numberOfIterations() << std::endl;
+        }
+
+        if (!checkpointFile.empty())
+        {
+            solver.enableCheckpoints(checkpointFile, checkpointInterval);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        bool hasLanded = false;
+
+        while (!hasLanded && (maxIterations == 0 || solver.numberOfIterations() < maxIterations))
+        {
+            hasLanded = solver.geneticIteration();
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << (hasLanded ? "Landed" : "No landing") << " after " << solver.numberOfIterations()
+                  << " iterations, " << solver.numberOfEvaluations() << " evaluations (" << seconds << " s)" << std::endl;
+        if (hasLanded && !replayFile.empty())
+        {
+            saveReplay(solver.replay(), replayFile);
+        }
+
+        if (hasLanded && !storeFile.empty())
+        {
+            if (warm.coldGenerations > 0)
+            {
+                std::cout << "Generations saved by the warm start : " << warm.coldGenerations - static_cast<double>(solver.numberOfIterations())
+                          << " (" << warm.coldGenerations << " for a cold search on the closest levels)" << std::endl;
+            }
+
+            const std::uint32_t coldGenerations = warm.genomes.empty() && resumeFile.empty() ? static_cast<std::uint32_t>(solver.numberOfIterations()) : 0;
+            store.add({preparedLevel->hash, features, coldGenerations, solver.replay().genes});
+            store.save(storeFile);
+        }
+
+        std::cout << "Population digest : " << std::hex << populationDigest(solver.population()) << std::dec << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "\nEXCEPTION: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
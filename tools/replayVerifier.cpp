@@ -0,0 +1,126 @@
+// Flies stored replays again with the physics core and checks that each of
+// them still lands, to catch regressions of the simulation. Replays are
+// matched with their level through the level content hash.
+//
+// Usage : REPLAY_VERIFIER <levelDirectory> <replay files or directories...>
+
+#include "levelCache.hpp"
+#include "phenotype.hpp"
+#include "replay.hpp"
+#include "rollout.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct VerifiedLevel
+    {
+        std::string fileName;
+        Lander lander;
+        std::shared_ptr<const PreparedLevel> preparedLevel;
+    };
+
+    std::unordered_map<std::uint64_t, VerifiedLevel> loadLevels(const std::string& directory)
+    {
+        std::unordered_map<std::uint64_t, VerifiedLevel> levels;
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            if (entry.path().extension() != ".txt")
+                continue;
+
+            std::shared_ptr<const PreparedLevel> preparedLevel = levelCache().load(entry.path().string());
+            const LevelData& data = preparedLevel->level.data;
+            levels[preparedLevel->hash] = {entry.path().string(),
+                                           Lander(data.position, data.velocity, data.fuel, data.angle, data.thrust),
+                                           preparedLevel};
+        }
+
+        return levels;
+    }
+
+    std::vector<std::string> listReplays(int argc, char* argv[])
+    {
+        std::vector<std::string> fileNames;
+
+        for (int i = 2; i < argc; ++i)
+        {
+            if (std::filesystem::is_directory(argv[i]))
+            {
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(argv[i]))
+                {
+                    if (entry.path().extension() == ".replay")
+                        fileNames.push_back(entry.path().string());
+                }
+            }
+            else
+            {
+                fileNames.push_back(argv[i]);
+            }
+        }
+
+        return fileNames;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (argc < 3)
+        {
+            throw std::runtime_error("Usage : REPLAY_VERIFIER <levelDirectory> <replay files or directories...>");
+        }
+
+        const auto levels = loadLevels(argv[1]);
+        const std::vector<std::string> fileNames = listReplays(argc, argv);
+
+        std::vector<Replay> replays;
+        replays.reserve(fileNames.size());
+        for (const std::string& fileName : fileNames)
+        {
+            replays.push_back(loadReplay(fileName));
+        }
+
+        std::size_t failures = 0;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < replays.size(); ++i)
+        {
+            const auto level = levels.find(replays[i].levelHash);
+            if (level == levels.end())
+            {
+                std::cout << "UNKNOWN LEVEL " << fileNames[i] << std::endl;
+                failures++;
+                continue;
+            }
+
+            const VerifiedLevel& verified = level->second;
+            const Phenotype phenotype(replays[i].genes, 0.0);
+            if (!rollout(verified.lander, phenotype, verified.preparedLevel->terrain).hasLanded)
+            {
+                std::cout << "FAILED " << fileNames[i] << " on " << verified.fileName << std::endl;
+                failures++;
+            }
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << replays.size() - failures << "/" << replays.size() << " replays still land ("
+                  << replays.size() / std::max(seconds, 1e-9) << " replays/s)" << std::endl;
+
+        return failures == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "\nEXCEPTION: " << e.what() << std::endl;
+        return 1;
+    }
+}